@@ -3,6 +3,8 @@
 
 #include "Common/Image.h"
 
+#include <array>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <vector>
@@ -71,6 +73,9 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   case ImageByteFormat::RGBA:
     color_type = SPNG_COLOR_TYPE_TRUECOLOR_ALPHA;
     break;
+  case ImageByteFormat::Gray:
+    color_type = SPNG_COLOR_TYPE_GRAYSCALE;
+    break;
   default:
     ASSERT_MSG(FRAMEDUMP, false, "Invalid format {}", static_cast<int>(format));
     return false;
@@ -120,6 +125,76 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   return true;
 }
 
+bool EncodePNG(std::vector<u8>* output, const u8* input, ImageByteFormat format, u32 width,
+               u32 height, u32 stride, int level)
+{
+  spng_color_type color_type;
+  switch (format)
+  {
+  case ImageByteFormat::RGB:
+    color_type = SPNG_COLOR_TYPE_TRUECOLOR;
+    break;
+  case ImageByteFormat::RGBA:
+    color_type = SPNG_COLOR_TYPE_TRUECOLOR_ALPHA;
+    break;
+  case ImageByteFormat::Gray:
+    color_type = SPNG_COLOR_TYPE_GRAYSCALE;
+    break;
+  default:
+    ASSERT_MSG(FRAMEDUMP, false, "Invalid format {}", static_cast<int>(format));
+    return false;
+  }
+
+  // Without a file or stream set, spng encodes into an internal buffer
+  auto ctx = make_spng_ctx(SPNG_CTX_ENCODER);
+  if (!ctx)
+    return false;
+
+  if (spng_set_option(ctx.get(), SPNG_ENCODE_TO_BUFFER, 1))
+    return false;
+
+  if (spng_set_option(ctx.get(), SPNG_IMG_COMPRESSION_LEVEL, level))
+    return false;
+
+  spng_ihdr ihdr{};
+  ihdr.width = width;
+  ihdr.height = height;
+  ihdr.color_type = color_type;
+  ihdr.bit_depth = 8;
+  if (spng_set_ihdr(ctx.get(), &ihdr))
+    return false;
+
+  if (spng_encode_image(ctx.get(), nullptr, 0, SPNG_FMT_PNG,
+                        SPNG_ENCODE_PROGRESSIVE | SPNG_ENCODE_FINALIZE))
+  {
+    return false;
+  }
+  for (u32 row = 0; row < height; row++)
+  {
+    const int err = spng_encode_row(ctx.get(), &input[row * stride], stride);
+    if (err == SPNG_EOI)
+      break;
+    if (err)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Failed to encode {} by {} image at level {}: error {}", width,
+                    height, level, err);
+      return false;
+    }
+  }
+
+  size_t png_size = 0;
+  int err = 0;
+  u8* png = static_cast<u8*>(spng_get_png_buffer(ctx.get(), &png_size, &err));
+  if (!png)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Failed to get encoded {} by {} image: error {}", width, height, err);
+    return false;
+  }
+  output->assign(png, png + png_size);
+  std::free(png);
+  return true;
+}
+
 static std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
 {
   std::vector<u8> buffer;
@@ -144,4 +219,103 @@ bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 wi
   const std::vector<u8> data = RGBAToRGB(input, width, height, stride);
   return SavePNG(path, data.data(), ImageByteFormat::RGB, width, height, width * 3, level);
 }
+
+bool ConvertRGBAToRGBAndEncodePNG(std::vector<u8>* output, const u8* input, u32 width, u32 height,
+                                  u32 stride, int level)
+{
+  const std::vector<u8> data = RGBAToRGB(input, width, height, stride);
+  return EncodePNG(output, data.data(), ImageByteFormat::RGB, width, height, width * 3, level);
+}
+
+void EncodeQOI(std::vector<u8>* output, const u8* input, u32 width, u32 height, u32 stride)
+{
+  constexpr u8 QOI_OP_INDEX = 0x00;
+  constexpr u8 QOI_OP_DIFF = 0x40;
+  constexpr u8 QOI_OP_LUMA = 0x80;
+  constexpr u8 QOI_OP_RUN = 0xc0;
+  constexpr u8 QOI_OP_RGB = 0xfe;
+
+  output->clear();
+  // Worst case is one QOI_OP_RGB per pixel, plus the 14 byte header and 8 byte end marker
+  output->reserve(14 + static_cast<size_t>(width) * height * 4 + 8);
+
+  const auto put32 = [output](u32 value) {
+    output->push_back(static_cast<u8>(value >> 24));
+    output->push_back(static_cast<u8>(value >> 16));
+    output->push_back(static_cast<u8>(value >> 8));
+    output->push_back(static_cast<u8>(value));
+  };
+  output->insert(output->end(), {'q', 'o', 'i', 'f'});
+  put32(width);
+  put32(height);
+  output->push_back(3);  // RGB
+  output->push_back(0);  // sRGB with linear alpha
+
+  std::array<u32, 64> index{};
+  u32 previous = 0x000000ff;  // r, g, b = 0, a = 255, packed as RGBA
+  u32 run = 0;
+
+  for (u32 y = 0; y < height; y++)
+  {
+    const u8* row = input + static_cast<size_t>(y) * stride;
+    for (u32 x = 0; x < width; x++)
+    {
+      const u8* px = row + x * 4;
+      // Alpha is ignored, like screenshots saved as PNG, so every pixel is opaque
+      const u32 pixel = (u32{px[0]} << 24) | (u32{px[1]} << 16) | (u32{px[2]} << 8) | 0xff;
+
+      if (pixel == previous)
+      {
+        run++;
+        if (run == 62)
+        {
+          output->push_back(QOI_OP_RUN | (run - 1));
+          run = 0;
+        }
+        continue;
+      }
+
+      if (run > 0)
+      {
+        output->push_back(QOI_OP_RUN | (run - 1));
+        run = 0;
+      }
+
+      const u8 hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64;
+      if (index[hash] == pixel)
+      {
+        output->push_back(QOI_OP_INDEX | hash);
+      }
+      else
+      {
+        index[hash] = pixel;
+
+        const s8 vr = static_cast<s8>(px[0] - static_cast<u8>(previous >> 24));
+        const s8 vg = static_cast<s8>(px[1] - static_cast<u8>(previous >> 16));
+        const s8 vb = static_cast<s8>(px[2] - static_cast<u8>(previous >> 8));
+        const s8 vg_r = vr - vg;
+        const s8 vg_b = vb - vg;
+
+        if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+        {
+          output->push_back(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+        }
+        else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8)
+        {
+          output->push_back(QOI_OP_LUMA | (vg + 32));
+          output->push_back((vg_r + 8) << 4 | (vg_b + 8));
+        }
+        else
+        {
+          output->insert(output->end(), {QOI_OP_RGB, px[0], px[1], px[2]});
+        }
+      }
+      previous = pixel;
+    }
+  }
+
+  if (run > 0)
+    output->push_back(QOI_OP_RUN | (run - 1));
+  output->insert(output->end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
 }  // namespace Common
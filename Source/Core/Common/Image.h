@@ -17,10 +17,19 @@ enum class ImageByteFormat
 {
   RGB,
   RGBA,
+  Gray,
 };
 
 bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
              u32 height, u32 stride, int level = 6);
 bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 width, u32 height,
                                 u32 stride, int level);
+// Encodes to a PNG in memory rather than to a file.
+bool EncodePNG(std::vector<u8>* output, const u8* input, ImageByteFormat format, u32 width,
+               u32 height, u32 stride, int level = 6);
+bool ConvertRGBAToRGBAndEncodePNG(std::vector<u8>* output, const u8* input, u32 width, u32 height,
+                                  u32 stride, int level);
+// Encodes RGBA8 input as an RGB QOI image (https://qoiformat.org), dropping alpha. Several times
+// faster to encode than PNG, at a similar size for emulated frames.
+void EncodeQOI(std::vector<u8>* output, const u8* input, u32 width, u32 height, u32 stride);
 }  // namespace Common
@@ -0,0 +1,85 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/JobPool.h"
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+JobPool::JobPool(u32 num_workers, std::string_view thread_name) : m_thread_name(thread_name)
+{
+  for (u32 i = 0; i < num_workers; i++)
+    m_threads.emplace_back(&JobPool::WorkerThread, this, i + 1);
+}
+
+JobPool::~JobPool()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_quit = true;
+  }
+  m_wake.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+void JobPool::Run(size_t num_jobs, const Job& job)
+{
+  // Not worth waking anyone for
+  if (num_jobs <= 1 || m_threads.empty())
+  {
+    for (size_t i = 0; i < num_jobs; i++)
+      job(i, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_job = &job;
+    m_num_jobs = num_jobs;
+    m_next_job.store(0, std::memory_order_relaxed);
+    m_pending = GetNumWorkers();
+    m_generation++;
+  }
+  m_wake.notify_all();
+
+  RunJobs(0);
+
+  std::unique_lock<std::mutex> lk(m_mutex);
+  m_done.wait(lk, [this] { return m_pending == 0; });
+}
+
+void JobPool::WorkerThread(u32 thread)
+{
+  SetCurrentThreadName(m_thread_name.c_str());
+
+  u64 generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_wake.wait(lk, [&] { return m_quit || m_generation != generation; });
+      if (m_quit)
+        return;
+      generation = m_generation;
+    }
+
+    RunJobs(thread);
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (--m_pending == 0)
+      m_done.notify_one();
+  }
+}
+
+void JobPool::RunJobs(u32 thread)
+{
+  for (size_t i = m_next_job.fetch_add(1, std::memory_order_relaxed); i < m_num_jobs;
+       i = m_next_job.fetch_add(1, std::memory_order_relaxed))
+  {
+    (*m_job)(i, thread);
+  }
+}
+}  // namespace Common
@@ -0,0 +1,62 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// [emubench] Splits a batch of numbered jobs between the calling thread and a fixed set of
+// worker threads, which sleep between batches. Jobs are handed out in index order as threads
+// become free, so a batch may mix cheap and expensive jobs.
+class JobPool
+{
+public:
+  // Called with the index of the job, and the thread running it: 0 for the thread that called
+  // Run, 1 to GetNumWorkers() for the workers. Each thread runs one job at a time, so the second
+  // argument can pick per-thread state.
+  using Job = std::function<void(size_t index, u32 thread)>;
+
+  JobPool(u32 num_workers, std::string_view thread_name);
+  ~JobPool();
+
+  JobPool(const JobPool&) = delete;
+  JobPool& operator=(const JobPool&) = delete;
+
+  u32 GetNumWorkers() const { return static_cast<u32>(m_threads.size()); }
+  // Including the thread that calls Run
+  u32 GetNumThreads() const { return GetNumWorkers() + 1; }
+
+  // Runs job for every index below num_jobs, and returns once they are all done. Not reentrant;
+  // callers sharing a pool need their own locking.
+  void Run(size_t num_jobs, const Job& job);
+
+private:
+  void WorkerThread(u32 thread);
+  void RunJobs(u32 thread);
+
+  std::string m_thread_name;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  u64 m_generation = 0;
+  u32 m_pending = 0;
+  bool m_quit = false;
+
+  const Job* m_job = nullptr;
+  size_t m_num_jobs = 0;
+  std::atomic<size_t> m_next_job = 0;
+};
+}  // namespace Common
@@ -104,6 +104,10 @@ extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
+// [emubench] Threads rasterizing screen tiles, including the video thread. -1 picks one.
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
+// [emubench] Threads decoding large textures on the CPU, including the video thread. -1 picks one.
+extern const Info<int> GFX_TEXTURE_DECODE_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
@@ -169,6 +173,8 @@ extern const Info<bool> GFX_HACK_DISABLE_COPY_TO_VRAM;
 extern const Info<bool> GFX_HACK_DEFER_EFB_COPIES;
 extern const Info<bool> GFX_HACK_IMMEDIATE_XFB;
 extern const Info<bool> GFX_HACK_SKIP_DUPLICATE_XFBS;
+// [emubench]
+extern const Info<bool> GFX_HACK_SKIP_UNOBSERVED_FRAMES;
 extern const Info<bool> GFX_HACK_EARLY_XFB_OUTPUT;
 extern const Info<bool> GFX_HACK_COPY_EFB_SCALED;
 extern const Info<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
@@ -75,7 +75,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, !HasEvents(), "Cannot unregister events with events pending");
   m_event_types.clear();
 }
 
@@ -91,6 +91,8 @@ void CoreTimingManager::Init()
   m_globals.slice_length = MAX_SLICE_LENGTH;
   m_globals.global_timer = 0;
   m_idled_cycles = 0;
+  m_idle_skip_count.store(0, std::memory_order_relaxed);
+  m_idle_skipped_cycles.store(0, std::memory_order_relaxed);
 
   // The time between CoreTiming being initialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -139,6 +141,8 @@ void CoreTimingManager::RefreshConfig()
   m_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
 
   m_use_precision_timer = Config::Get(Config::MAIN_PRECISION_FRAME_TIMING);
+
+  SetUseTimingWheel(Config::Get(Config::MAIN_TIMING_WHEEL));
 }
 
 void CoreTimingManager::DoState(PointerWrap& p)
@@ -158,6 +162,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  // [emubench] Savestates hold the events in no particular order, so the timing wheel goes
+  // through the same vector as the heap
+  if (m_use_timing_wheel)
+    m_event_queue = m_timing_wheel.TakeAll();
   p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -191,12 +199,19 @@ void CoreTimingManager::DoState(PointerWrap& p)
   });
   p.DoMarker("CoreTimingEvents");
 
+  if (m_use_timing_wheel)
+  {
+    m_timing_wheel.Assign(std::move(m_event_queue));
+    m_event_queue.clear();
+  }
+
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
     // The exact layout of the heap in memory is implementation defined, therefore it is platform
     // and library version specific.
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
+    if (!m_use_timing_wheel)
+      std::ranges::make_heap(m_event_queue, std::ranges::greater{});
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -222,9 +237,73 @@ u64 CoreTimingManager::GetIdleTicks() const
   return static_cast<u64>(m_idled_cycles);
 }
 
+CoreTimingManager::IdleSkipStats CoreTimingManager::GetIdleSkipStats() const
+{
+  return {m_idle_skip_count.load(std::memory_order_relaxed),
+          m_idle_skipped_cycles.load(std::memory_order_relaxed)};
+}
+
 void CoreTimingManager::ClearPendingEvents()
 {
   m_event_queue.clear();
+  m_timing_wheel.Clear();
+}
+
+void CoreTimingManager::PushEvent(const Event& ev)
+{
+  if (m_use_timing_wheel)
+  {
+    m_timing_wheel.Push(ev);
+    return;
+  }
+
+  m_event_queue.push_back(ev);
+  std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+}
+
+bool CoreTimingManager::HasEvents() const
+{
+  return m_use_timing_wheel ? !m_timing_wheel.IsEmpty() : !m_event_queue.empty();
+}
+
+const Event& CoreTimingManager::NextEvent() const
+{
+  return m_use_timing_wheel ? m_timing_wheel.Top() : m_event_queue.front();
+}
+
+Event CoreTimingManager::PopEvent()
+{
+  if (m_use_timing_wheel)
+    return m_timing_wheel.Pop();
+
+  Event evt = std::move(m_event_queue.front());
+  std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
+  m_event_queue.pop_back();
+  return evt;
+}
+
+std::vector<Event> CoreTimingManager::CopyEvents() const
+{
+  return m_use_timing_wheel ? m_timing_wheel.Copy() : m_event_queue;
+}
+
+void CoreTimingManager::SetUseTimingWheel(bool use_timing_wheel)
+{
+  if (m_use_timing_wheel == use_timing_wheel)
+    return;
+
+  // Both keep the same (time, fifo_order) ordering, so pending events carry over as they are
+  if (use_timing_wheel)
+  {
+    m_timing_wheel.Assign(std::move(m_event_queue));
+    m_event_queue.clear();
+  }
+  else
+  {
+    m_event_queue = m_timing_wheel.TakeAll();
+    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
+  }
+  m_use_timing_wheel = use_timing_wheel;
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -253,8 +332,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    PushEvent(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -273,6 +351,12 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
+  if (m_use_timing_wheel)
+  {
+    m_timing_wheel.RemoveAll(event_type);
+    return;
+  }
+
   const size_t erased =
       std::erase_if(m_event_queue, [&](const Event& e) { return e.type == event_type; });
 
@@ -307,8 +391,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    PushEvent(ev);
   }
 }
 
@@ -329,21 +412,19 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (HasEvents() && NextEvent().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
-    m_event_queue.pop_back();
+    Event evt = PopEvent();
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
   }
 
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (HasEvents())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(NextEvent().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -451,7 +532,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
+  auto clone = CopyEvents();
   std::ranges::sort(clone);
   for (const Event& ev : clone)
   {
@@ -467,11 +548,20 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
 
   m_throttle_clock_per_sec = new_ppc_clock;
 
+  if (m_use_timing_wheel)
+    m_event_queue = m_timing_wheel.TakeAll();
+
   for (Event& ev : m_event_queue)
   {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
   }
+
+  if (m_use_timing_wheel)
+  {
+    m_timing_wheel.Assign(std::move(m_event_queue));
+    m_event_queue.clear();
+  }
 }
 
 void CoreTimingManager::Idle()
@@ -486,8 +576,16 @@ void CoreTimingManager::Idle()
 
   auto& ppc_state = m_system.GetPPCState();
   PowerPC::UpdatePerformanceMonitor(ppc_state.downcount, 0, 0, ppc_state);
-  m_idled_cycles += DowncountToCycles(ppc_state.downcount);
+  const s64 skipped_cycles = DowncountToCycles(ppc_state.downcount);
+  m_idled_cycles += skipped_cycles;
   ppc_state.downcount = 0;
+
+  // [emubench] Only the CPU thread writes these, so relaxed read-modify-writes are enough
+  if (skipped_cycles > 0)
+  {
+    m_idle_skip_count.fetch_add(1, std::memory_order_relaxed);
+    m_idle_skipped_cycles.fetch_add(static_cast<u64>(skipped_cycles), std::memory_order_relaxed);
+  }
 }
 
 std::string CoreTimingManager::GetScheduledEventsSummary() const
@@ -495,7 +593,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
+  auto clone = CopyEvents();
   std::ranges::sort(clone);
   for (const Event& ev : clone)
   {
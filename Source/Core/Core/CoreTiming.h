@@ -16,6 +16,8 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -81,6 +83,95 @@ enum class FromThread
   ANY
 };
 
+// [emubench] Hierarchical timing wheel, an alternative to keeping the event queue as a binary
+// heap. Scheduling and cancelling are O(1). Finding the next event is O(1) while it is in a level 0
+// slot; otherwise it takes a scan of the lowest occupied slot, whose result is cached until the
+// wheel changes, and popping it cascades that slot to lower levels. Events come out in exactly the
+// heap's order: by time, then by fifo_order.
+//
+// Times are split into 6-bit digits. An event lives on the level of the highest digit in which
+// its time differs from the time of the last popped event, in the slot given by that digit. All
+// events on a level are earlier than those on any higher level, and a level 0 slot only holds
+// events with one exact time, kept in fifo_order. Events scheduled before the last popped event
+// (late events from other threads, or negative delays) go to a small sorted list instead.
+class TimingWheel
+{
+public:
+  TimingWheel();
+
+  bool IsEmpty() const { return m_size == 0; }
+  size_t Size() const { return m_size; }
+
+  // fifo_order must be higher than that of any event already in the wheel, except when
+  // rebuilding it through Assign.
+  void Push(const Event& event);
+  // Must not be called on an empty wheel
+  const Event& Top() const;
+  Event Pop();
+  // Removes every event of the given type; returns how many there were
+  size_t RemoveAll(EventType* type);
+  void Clear();
+
+  // Replaces the contents with the given events, which may be in any order
+  void Assign(std::vector<Event> events);
+  // Removes all events, returned in no particular order
+  std::vector<Event> TakeAll();
+  // Copies all events, in no particular order
+  std::vector<Event> Copy() const;
+
+private:
+  static constexpr u32 BITS_PER_LEVEL = 6;
+  static constexpr u32 SLOTS_PER_LEVEL = 1 << BITS_PER_LEVEL;
+  static constexpr u32 NUM_LEVELS = (64 + BITS_PER_LEVEL - 1) / BITS_PER_LEVEL;
+  static constexpr u32 NUM_BUCKETS = NUM_LEVELS * SLOTS_PER_LEVEL;
+  static constexpr u32 LATE_BUCKET = NUM_BUCKETS;
+  static constexpr u32 INVALID_NODE = UINT32_MAX;
+
+  struct Node
+  {
+    Event event;
+    // Links within the bucket, and within the list of events of the same type
+    u32 prev;
+    u32 next;
+    u32 type_prev;
+    u32 type_next;
+    u32 bucket;
+  };
+
+  struct Bucket
+  {
+    u32 head = INVALID_NODE;
+    u32 tail = INVALID_NODE;
+  };
+
+  // Event times as unsigned values with the same ordering
+  static u64 ToKey(s64 time) { return static_cast<u64>(time) ^ (u64{1} << 63); }
+
+  u32 AllocateNode(const Event& event);
+  void FreeNode(u32 index);
+  void Insert(u32 index);
+  void LinkToBucket(u32 index, u32 bucket);
+  void UnlinkFromBucket(u32 index);
+  void UnlinkFromType(u32 index);
+  void Cascade(u32 bucket);
+  // Node holding the next event; the wheel must not be empty
+  u32 FindTop() const;
+  // FindTop through m_top
+  u32 GetTop() const;
+
+  std::vector<Node> m_nodes;
+  std::vector<u32> m_free_nodes;
+  std::array<Bucket, NUM_BUCKETS> m_buckets{};
+  std::array<u64, NUM_LEVELS> m_occupied{};
+  // Node indices of late events, sorted by time and fifo_order
+  std::vector<u32> m_late;
+  std::unordered_map<EventType*, u32> m_type_heads;
+  u64 m_now_key = 0;
+  size_t m_size = 0;
+  // Result of the last FindTop, or INVALID_NODE if it has to be looked up again
+  mutable u32 m_top = INVALID_NODE;
+};
+
 // helpers until the JIT is updated to use the instance
 void GlobalAdvance();
 void GlobalIdle();
@@ -99,6 +190,15 @@ public:
   // doing something evil
   u64 GetTicks() const;
   u64 GetIdleTicks() const;
+
+  // [emubench] Cycles skipped by Idle() since Init, readable from any thread. Unlike
+  // GetIdleTicks() these aren't part of savestates, so loading a state doesn't rewind them.
+  struct IdleSkipStats
+  {
+    u64 skips = 0;
+    u64 skipped_cycles = 0;
+  };
+  IdleSkipStats GetIdleSkipStats() const;
   TimePoint GetTargetHostTime(s64 target_cycle);
 
   void RefreshConfig();
@@ -182,6 +282,9 @@ private:
   // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accommodated
   // by the standard adaptor class.
   std::vector<Event> m_event_queue;
+  // [emubench] Holds the events instead of m_event_queue while m_use_timing_wheel is set
+  TimingWheel m_timing_wheel;
+  bool m_use_timing_wheel = false;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -189,6 +292,9 @@ private:
   float m_last_oc_factor = 0.0f;
 
   s64 m_idled_cycles = 0;
+  // [emubench] See GetIdleSkipStats
+  std::atomic<u64> m_idle_skip_count = 0;
+  std::atomic<u64> m_idle_skipped_cycles = 0;
   u32 m_fake_dec_start_value = 0;
   u64 m_fake_dec_start_ticks = 0;
 
@@ -216,6 +322,14 @@ private:
   int DowncountToCycles(int downcount) const;
   int CyclesToDowncount(int cycles) const;
 
+  // [emubench] Event queue operations, on whichever of the heap and the timing wheel is in use
+  void PushEvent(const Event& ev);
+  bool HasEvents() const;
+  const Event& NextEvent() const;
+  Event PopEvent();
+  std::vector<Event> CopyEvents() const;
+  void SetUseTimingWheel(bool use_timing_wheel);
+
   std::atomic_bool m_use_precision_timer = false;
   Common::PrecisionTimer m_precision_cpu_timer;
   Common::PrecisionTimer m_precision_gpu_timer;
@@ -0,0 +1,276 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+#include "Common/Assert.h"
+#include "Core/CoreTiming.h"
+
+namespace CoreTiming
+{
+TimingWheel::TimingWheel() = default;
+
+u32 TimingWheel::AllocateNode(const Event& event)
+{
+  u32 index;
+  if (m_free_nodes.empty())
+  {
+    index = static_cast<u32>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+  else
+  {
+    index = m_free_nodes.back();
+    m_free_nodes.pop_back();
+  }
+
+  m_nodes[index] = {event, INVALID_NODE, INVALID_NODE, INVALID_NODE, INVALID_NODE, INVALID_NODE};
+  return index;
+}
+
+void TimingWheel::FreeNode(u32 index)
+{
+  m_nodes[index].bucket = INVALID_NODE;
+  m_free_nodes.push_back(index);
+}
+
+void TimingWheel::Insert(u32 index)
+{
+  Node& node = m_nodes[index];
+  const u64 key = ToKey(node.event.time);
+  if (key < m_now_key)
+  {
+    const auto it = std::ranges::upper_bound(
+        m_late, node.event, {}, [this](u32 i) -> const Event& { return m_nodes[i].event; });
+    m_late.insert(it, index);
+    node.bucket = LATE_BUCKET;
+    return;
+  }
+
+  const u64 diff = key ^ m_now_key;
+  const u32 level = diff == 0 ? 0 : (63 - std::countl_zero(diff)) / BITS_PER_LEVEL;
+  const u32 slot = (key >> (level * BITS_PER_LEVEL)) & (SLOTS_PER_LEVEL - 1);
+  LinkToBucket(index, level * SLOTS_PER_LEVEL + slot);
+}
+
+void TimingWheel::LinkToBucket(u32 index, u32 bucket_index)
+{
+  Node& node = m_nodes[index];
+  Bucket& bucket = m_buckets[bucket_index];
+  node.bucket = bucket_index;
+  node.prev = bucket.tail;
+  node.next = INVALID_NODE;
+  if (bucket.tail != INVALID_NODE)
+    m_nodes[bucket.tail].next = index;
+  else
+    bucket.head = index;
+  bucket.tail = index;
+
+  m_occupied[bucket_index / SLOTS_PER_LEVEL] |= u64{1} << (bucket_index % SLOTS_PER_LEVEL);
+}
+
+void TimingWheel::UnlinkFromBucket(u32 index)
+{
+  const Node& node = m_nodes[index];
+  if (node.bucket == LATE_BUCKET)
+  {
+    std::erase(m_late, index);
+    return;
+  }
+
+  Bucket& bucket = m_buckets[node.bucket];
+  if (node.prev != INVALID_NODE)
+    m_nodes[node.prev].next = node.next;
+  else
+    bucket.head = node.next;
+  if (node.next != INVALID_NODE)
+    m_nodes[node.next].prev = node.prev;
+  else
+    bucket.tail = node.prev;
+
+  if (bucket.head == INVALID_NODE)
+    m_occupied[node.bucket / SLOTS_PER_LEVEL] &= ~(u64{1} << (node.bucket % SLOTS_PER_LEVEL));
+}
+
+void TimingWheel::UnlinkFromType(u32 index)
+{
+  const Node& node = m_nodes[index];
+  if (node.type_prev != INVALID_NODE)
+    m_nodes[node.type_prev].type_next = node.type_next;
+  else
+    m_type_heads[node.event.type] = node.type_next;
+  if (node.type_next != INVALID_NODE)
+    m_nodes[node.type_next].type_prev = node.type_prev;
+}
+
+void TimingWheel::Cascade(u32 bucket_index)
+{
+  Bucket& bucket = m_buckets[bucket_index];
+  u32 index = bucket.head;
+  bucket = {};
+  m_occupied[bucket_index / SLOTS_PER_LEVEL] &= ~(u64{1} << (bucket_index % SLOTS_PER_LEVEL));
+
+  // Every event here is at or after m_now_key, so each lands on a lower level. Those are all empty
+  // and events are re-linked in list order, which keeps equal times in fifo_order.
+  while (index != INVALID_NODE)
+  {
+    const u32 next = m_nodes[index].next;
+    Insert(index);
+    index = next;
+  }
+}
+
+u32 TimingWheel::FindTop() const
+{
+  if (!m_late.empty())
+    return m_late.front();
+
+  for (u32 level = 0; level < NUM_LEVELS; ++level)
+  {
+    if (m_occupied[level] == 0)
+      continue;
+
+    const u32 slot = static_cast<u32>(std::countr_zero(m_occupied[level]));
+    const Bucket& bucket = m_buckets[level * SLOTS_PER_LEVEL + slot];
+    if (level == 0)
+      return bucket.head;
+
+    // Slots above level 0 cover a range of times, so look for the earliest
+    u32 top = bucket.head;
+    for (u32 index = m_nodes[top].next; index != INVALID_NODE; index = m_nodes[index].next)
+    {
+      if (m_nodes[index].event < m_nodes[top].event)
+        top = index;
+    }
+    return top;
+  }
+
+  ASSERT_MSG(POWERPC, false, "TimingWheel is empty");
+  return INVALID_NODE;
+}
+
+u32 TimingWheel::GetTop() const
+{
+  if (m_top == INVALID_NODE)
+    m_top = FindTop();
+  return m_top;
+}
+
+void TimingWheel::Push(const Event& event)
+{
+  const u32 index = AllocateNode(event);
+
+  u32& type_head = m_type_heads.try_emplace(event.type, INVALID_NODE).first->second;
+  Node& node = m_nodes[index];
+  node.type_next = type_head;
+  if (type_head != INVALID_NODE)
+    m_nodes[type_head].type_prev = index;
+  type_head = index;
+
+  Insert(index);
+  ++m_size;
+
+  // A new event can only take over the top, since FindTop returns the earliest of all events
+  if (m_top != INVALID_NODE && event < m_nodes[m_top].event)
+    m_top = index;
+}
+
+const Event& TimingWheel::Top() const
+{
+  return m_nodes[GetTop()].event;
+}
+
+Event TimingWheel::Pop()
+{
+  u32 index = GetTop();
+  m_top = INVALID_NODE;
+  const u32 bucket = m_nodes[index].bucket;
+  if (bucket != LATE_BUCKET)
+  {
+    m_now_key = ToKey(m_nodes[index].event.time);
+    if (bucket >= SLOTS_PER_LEVEL)
+    {
+      // Spread the slot over the lower levels relative to the new time. The event found above then
+      // heads the level 0 slot for its exact time.
+      Cascade(bucket);
+      index = m_buckets[m_now_key % SLOTS_PER_LEVEL].head;
+    }
+  }
+
+  UnlinkFromBucket(index);
+  UnlinkFromType(index);
+  const Event event = m_nodes[index].event;
+  FreeNode(index);
+  --m_size;
+  return event;
+}
+
+size_t TimingWheel::RemoveAll(EventType* type)
+{
+  const auto it = m_type_heads.find(type);
+  if (it == m_type_heads.end())
+    return 0;
+
+  size_t removed = 0;
+  for (u32 index = it->second; index != INVALID_NODE;)
+  {
+    const u32 next = m_nodes[index].type_next;
+    UnlinkFromBucket(index);
+    FreeNode(index);
+    index = next;
+    ++removed;
+  }
+  it->second = INVALID_NODE;
+  m_size -= removed;
+  if (removed != 0)
+    m_top = INVALID_NODE;
+  return removed;
+}
+
+void TimingWheel::Clear()
+{
+  m_nodes.clear();
+  m_free_nodes.clear();
+  m_buckets.fill({});
+  m_occupied.fill(0);
+  m_late.clear();
+  m_type_heads.clear();
+  m_now_key = 0;
+  m_size = 0;
+  m_top = INVALID_NODE;
+}
+
+void TimingWheel::Assign(std::vector<Event> events)
+{
+  Clear();
+
+  // Inserting in order keeps equal times in fifo_order within their slots. The wheel restarts
+  // from the earliest possible time, so no event scheduled afterwards counts as late.
+  std::ranges::sort(events);
+  for (const Event& event : events)
+    Push(event);
+}
+
+std::vector<Event> TimingWheel::TakeAll()
+{
+  std::vector<Event> events = Copy();
+  Clear();
+  return events;
+}
+
+std::vector<Event> TimingWheel::Copy() const
+{
+  std::vector<Event> events;
+  events.reserve(m_size);
+  for (const Node& node : m_nodes)
+  {
+    if (node.bucket != INVALID_NODE)
+      events.push_back(node.event);
+  }
+  return events;
+}
+
+}  // namespace CoreTiming
@@ -92,6 +92,15 @@ void AdvanceFrame(int pad_num)
                     timed_queue.end());
 }
 
+void ClearTimedInputs(int pad_num)
+{
+  if (pad_num < 0 || pad_num >= 4)
+    return;
+
+  std::lock_guard<std::mutex> lock(s_http_controllers[pad_num].mutex);
+  s_http_controllers[pad_num].timed_inputs.clear();
+}
+
 void UpdateControllerStateFromHTTP(int pad_num, const GCPadStatus& status)
 {
   if (pad_num < 0 || pad_num >= 4)
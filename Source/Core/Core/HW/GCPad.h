@@ -42,6 +42,12 @@ void QueueTimedInput(int pad_num, const GCPadStatus& status, uint32_t frames);
  * @param pad_num The controller port (0-3).
  */
 void AdvanceFrame(int pad_num);
+
+/**
+ * @brief Drops all queued timed inputs for a controller port, e.g. when a sequence ends early.
+ * @param pad_num The controller port (0-3).
+ */
+void ClearTimedInputs(int pad_num);
 void UpdateControllerStateFromHTTP(int pad_num, const GCPadStatus& status);
 void EnableHTTPController(int pad_num, bool enabled);
 
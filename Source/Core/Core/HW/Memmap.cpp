@@ -328,15 +328,22 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
-  p.DoArray(m_ram, current_ram_size);
+  // [emubench]
+  const bool external_regions = static_cast<bool>(m_state_region_handler);
+
+  if (!external_regions)
+    p.DoArray(m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
-  if (current_have_fake_vmem)
+  if (current_have_fake_vmem && !external_regions)
     p.DoArray(m_fake_vmem, current_fake_vmem_size);
   p.DoMarker("Memory FakeVMEM");
-  if (current_have_exram)
+  if (current_have_exram && !external_regions)
     p.DoArray(m_exram, current_exram_size);
   p.DoMarker("Memory EXRAM");
+
+  if (external_regions)
+    m_state_region_handler(p);
 }
 
 void MemoryManager::Shutdown()
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <span>
 #include <string>
@@ -99,6 +100,14 @@ public:
   void ShutdownFastmemArena();
   void DoState(PointerWrap& p);
 
+  // [emubench] When set, DoState leaves MEM1, fake VMEM and MEM2 out of the state and calls the
+  // handler in their place, so the caller can store them itself (IPC delta snapshots).
+  using StateRegionHandler = std::function<void(PointerWrap& p)>;
+  void SetStateRegionHandler(StateRegionHandler handler)
+  {
+    m_state_region_handler = std::move(handler);
+  }
+
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
   void Clear();
@@ -176,6 +185,9 @@ private:
   u8* m_l1_cache = nullptr;
   u8* m_fake_vmem = nullptr;
 
+  // [emubench]
+  StateRegionHandler m_state_region_handler;
+
   // m_ram_size is the amount allocated by the emulator, whereas m_ram_size_real
   // is what will be reported in lowmem, and thus used by emulated software.
   // Note: Writing to lowmem is done by IPL. If using retail IPL, it will
@@ -39,7 +39,9 @@ void CachedInterpreter::Init()
   AllocCodeSpace(CODE_SIZE);
   ResetFreeMemoryRanges();
 
-  jo.enableBlocklink = false;
+  EnableBlockLink();
+  // [emubench] Moves compares next to their branches, so more of them can be fused
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
 
   m_block_cache.Init();
 
@@ -118,6 +120,35 @@ s32 CachedInterpreter::EndBlock(PowerPC::PowerPCState& ppc_state,
   return 0;
 }
 
+template <bool profiled>
+s32 CachedInterpreter::EndBlockAndLink(PowerPC::PowerPCState& ppc_state,
+                                       const EndBlockOperands<profiled>& operands)
+{
+  EndBlock<profiled>(ppc_state, operands);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LinkBlock(PowerPC::PowerPCState& ppc_state,
+                                 const LinkBlockOperands& operands)
+{
+  const auto& [destination, exit_address, feature_flags] = operands;
+  // Same condition the dispatcher would check before looking up the next block. Exits that
+  // don't match fall through to the next LinkBlock, or to ExitBlock after the last one.
+  if (destination == nullptr || ppc_state.pc != exit_address ||
+      ppc_state.feature_flags != feature_flags || ppc_state.downcount <= 0)
+  {
+    return sizeof(AnyCallback) + sizeof(operands);
+  }
+  // Distance from this callback to the first callback of the destination block
+  return static_cast<s32>(destination -
+                          (reinterpret_cast<const u8*>(&operands) - sizeof(AnyCallback)));
+}
+
+s32 CachedInterpreter::ExitBlock(PowerPC::PowerPCState& ppc_state, const void* operands)
+{
+  return 0;
+}
+
 template <bool write_pc>
 s32 CachedInterpreter::Interpret(PowerPC::PowerPCState& ppc_state,
                                  const InterpretOperands& operands)
@@ -206,6 +237,11 @@ s32 CachedInterpreter::CheckIdle(PowerPC::PowerPCState& ppc_state,
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
+void CachedInterpreter::EnableBlockLink()
+{
+  jo.enableBlocklink = !SConfig::GetInstance().bJITNoBlockLinking;
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   // CachedInterpreter inherits from JitBase and is considered a JIT by relevant code.
@@ -224,17 +260,39 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   return true;
 }
 
-void CachedInterpreter::WriteEndBlock()
+void CachedInterpreter::WriteEndBlock(std::initializer_list<u32> exit_addresses)
 {
+  const bool link = jo.enableBlocklink && exit_addresses.size() != 0;
+
   if (IsProfilingEnabled())
   {
-    Write(EndBlock<true>, {{js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst},
-                           js.curBlock->profile_data.get()});
+    const EndBlockOperands<true> operands = {
+        {js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst},
+        js.curBlock->profile_data.get()};
+    Write(link ? CallbackCast(EndBlockAndLink<true>) : CallbackCast(EndBlock<true>), operands);
   }
   else
   {
-    Write(EndBlock<false>, {js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst});
+    const EndBlockOperands<false> operands = {js.downcountAmount, js.numLoadStoreInst,
+                                              js.numFloatingPointInst};
+    Write(link ? CallbackCast(EndBlockAndLink<false>) : CallbackCast(EndBlock<false>), operands);
+  }
+
+  if (!link)
+    return;
+
+  for (const u32 exit_address : exit_addresses)
+  {
+    JitBlock::LinkData link_data;
+    link_data.exitPtrs = GetWritableCodePtr() + sizeof(AnyCallback);
+    link_data.exitAddress = exit_address;
+    link_data.linkStatus = false;
+    link_data.call = false;
+    js.curBlock->linkData.push_back(link_data);
+
+    Write(LinkBlock, {nullptr, exit_address, js.curBlock->feature_flags});
   }
+  Write(ExitBlock);
 }
 
 bool CachedInterpreter::SetEmitterStateToFreeCodeRegion()
@@ -275,8 +333,16 @@ void CachedInterpreter::Jit(u32 em_address, bool clear_cache_and_retry_on_failur
   }
   FreeRanges();
 
-  const u32 nextPC =
-      analyzer.Analyze(em_address, &code_block, &m_code_buffer, m_code_buffer.size());
+  EnableBlockLink();
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+  if (IsDebuggingEnabled() && m_system.GetCPU().IsStepping())
+  {
+    // Do not link this block to other blocks while single stepping
+    jo.enableBlocklink = false;
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+  }
+
+  const u32 nextPC = AnalyzeBlock(em_address, m_code_buffer.size());
   if (code_block.m_memory_exception)
   {
     // Address of instruction could not be translated
@@ -343,6 +409,9 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     Write(StartProfiledBlock, {js.curBlock->profile_data.get()});
 
+  // [emubench] Set when the previous instruction's callback also performed this one
+  bool fused_with_previous = false;
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
@@ -372,9 +441,13 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         js.firstFPInstructionFound = true;
       }
 
+      if (fused_with_previous)
+      {
+        fused_with_previous = false;
+      }
       // Instruction may cause a DSI Exception or Program Exception.
-      if ((jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
-          (!op.canEndBlock && ShouldHandleFPExceptionForInstruction(&op)))
+      else if ((jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
+               (!op.canEndBlock && ShouldHandleFPExceptionForInstruction(&op)))
       {
         const InterpretAndCheckExceptionsOperands operands = {
             {interpreter, Interpreter::GetInterpreterOp(op.inst), js.compilerPC, op.inst},
@@ -384,7 +457,12 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
                                CallbackCast(InterpretAndCheckExceptions<false>),
               operands);
       }
-      else
+      else if (!op.canEndBlock && i + 1 < code_block.m_num_instructions &&
+               WriteFusedInstructions(op, m_code_buffer[i + 1]))
+      {
+        fused_with_previous = true;
+      }
+      else if (op.canEndBlock || !WriteSpecializedInstruction(op))
       {
         const InterpretOperands operands = {interpreter, Interpreter::GetInterpreterOp(op.inst),
                                             js.compilerPC, op.inst};
@@ -395,13 +473,20 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       if (op.branchIsIdleLoop)
         Write(CheckIdle, {m_system.GetCoreTiming(), js.blockStart});
       if (op.canEndBlock)
-        WriteEndBlock();
+      {
+        if (op.branchTo == UINT32_MAX)
+          WriteEndBlock();
+        else if (op.inst.OPCD == 16)  // bcx can also fall through
+          WriteEndBlock({op.branchTo, op.address + 4});
+        else
+          WriteEndBlock({op.branchTo});
+      }
     }
   }
   if (code_block.m_broken)
   {
     Write(WriteBrokenBlockNPC, {nextPC});
-    WriteEndBlock();
+    WriteEndBlock({nextPC});
   }
 
   if (HasWriteFailed())
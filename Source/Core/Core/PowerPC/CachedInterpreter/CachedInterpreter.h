@@ -4,6 +4,8 @@
 #pragma once
 
 #include <cstddef>
+#include <initializer_list>
+#include <optional>
 
 #include <rangeset/rangesizeset.h>
 
@@ -13,6 +15,10 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
+namespace Core
+{
+class BranchWatch;
+}
 namespace CoreTiming
 {
 class CoreTimingManager;
@@ -22,6 +28,10 @@ namespace CPU
 enum class State;
 }
 class Interpreter;
+namespace PowerPC
+{
+class MMU;
+}
 
 class CachedInterpreter : public JitBase, public CachedInterpreterCodeBlock
 {
@@ -58,11 +68,26 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
+  // [emubench] If `inst` is lis rD and `next_inst` completes the constant in rD (addi or ori),
+  // returns the value rD holds after both.
+  static std::optional<u32> GetFusedLoadImmediate(UGeckoInstruction inst,
+                                                  UGeckoInstruction next_inst);
+
 private:
   void ExecuteOneBlock();
 
+  void EnableBlockLink();
   bool HandleFunctionHooking(u32 address);
-  void WriteEndBlock();
+  // Ends the block. If block linking is enabled, the block may jump straight into the block at
+  // whichever of `exit_addresses` the guest continues at, once that block has been compiled.
+  void WriteEndBlock(std::initializer_list<u32> exit_addresses = {});
+  // Emits a pre-decoded callback for common instructions that cannot end the block. Returns false
+  // if the instruction has to go through the Interpreter instead.
+  bool WriteSpecializedInstruction(const PPCAnalyst::CodeOp& op);
+  // Emits a single callback for a common two-instruction idiom starting at `op`. Returns false if
+  // the pair doesn't form one. On success the callback also performs `next`, so `next` must not
+  // get a callback of its own.
+  bool WriteFusedInstructions(const PPCAnalyst::CodeOp& op, const PPCAnalyst::CodeOp& next);
 
   // Finds a free memory region and sets the code emitter to point at that region.
   // Returns false if no free memory region can be found.
@@ -76,12 +101,21 @@ private:
   struct StartProfiledBlockOperands;
   template <bool profiled>
   struct EndBlockOperands;
+  struct LinkBlockOperands;
   struct InterpretOperands;
   struct InterpretAndCheckExceptionsOperands;
   struct HLEFunctionOperands;
   struct WriteBrokenBlockNPCOperands;
   struct CheckHaltOperands;
   struct CheckIdleOperands;
+  struct LoadImmediateOperands;
+  struct ImmediateOperands;
+  struct RotateMaskOperands;
+  struct CompareOperands;
+  struct LoadStoreOperands;
+  struct PairedLoadStoreOperands;
+  struct CompareAndBranchOperands;
+  struct RotateMaskCompareOperands;
 
   static s32 StartProfiledBlock(PowerPC::PowerPCState& ppc_state,
                                 const StartProfiledBlockOperands& operands);
@@ -90,6 +124,15 @@ private:
   static s32 EndBlock(PowerPC::PowerPCState& ppc_state, const EndBlockOperands<profiled>& operands);
   template <bool profiled>
   static s32 EndBlock(std::ostream& stream, const EndBlockOperands<profiled>& operands);
+  template <bool profiled>
+  static s32 EndBlockAndLink(PowerPC::PowerPCState& ppc_state,
+                             const EndBlockOperands<profiled>& operands);
+  template <bool profiled>
+  static s32 EndBlockAndLink(std::ostream& stream, const EndBlockOperands<profiled>& operands);
+  static s32 LinkBlock(PowerPC::PowerPCState& ppc_state, const LinkBlockOperands& operands);
+  static s32 LinkBlock(std::ostream& stream, const LinkBlockOperands& operands);
+  static s32 ExitBlock(PowerPC::PowerPCState& ppc_state, const void* operands);
+  static s32 ExitBlock(std::ostream& stream, const void* operands);
   template <bool write_pc>
   static s32 Interpret(PowerPC::PowerPCState& ppc_state, const InterpretOperands& operands);
   template <bool write_pc>
@@ -112,6 +155,54 @@ private:
   static s32 CheckIdle(PowerPC::PowerPCState& ppc_state, const CheckIdleOperands& operands);
   static s32 CheckIdle(std::ostream& stream, const CheckIdleOperands& operands);
 
+  // [emubench] Specialized instructions (see CachedInterpreter_Instructions.cpp)
+  static s32 LoadImmediate(PowerPC::PowerPCState& ppc_state, const LoadImmediateOperands& operands);
+  static s32 LoadImmediate(std::ostream& stream, const LoadImmediateOperands& operands);
+  static s32 AddImmediate(PowerPC::PowerPCState& ppc_state, const ImmediateOperands& operands);
+  static s32 AddImmediate(std::ostream& stream, const ImmediateOperands& operands);
+  static s32 OrImmediate(PowerPC::PowerPCState& ppc_state, const ImmediateOperands& operands);
+  static s32 OrImmediate(std::ostream& stream, const ImmediateOperands& operands);
+  static s32 RotateAndMask(PowerPC::PowerPCState& ppc_state, const RotateMaskOperands& operands);
+  static s32 RotateAndMask(std::ostream& stream, const RotateMaskOperands& operands);
+  template <bool is_signed>
+  static s32 CompareRegister(PowerPC::PowerPCState& ppc_state, const CompareOperands& operands);
+  template <bool is_signed>
+  static s32 CompareRegister(std::ostream& stream, const CompareOperands& operands);
+  template <bool is_signed>
+  static s32 CompareImmediate(PowerPC::PowerPCState& ppc_state, const CompareOperands& operands);
+  template <bool is_signed>
+  static s32 CompareImmediate(std::ostream& stream, const CompareOperands& operands);
+  template <typename T>
+  static s32 LoadGPR(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands);
+  template <typename T>
+  static s32 LoadGPR(std::ostream& stream, const LoadStoreOperands& operands);
+  template <typename T>
+  static s32 StoreGPR(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands);
+  template <typename T>
+  static s32 StoreGPR(std::ostream& stream, const LoadStoreOperands& operands);
+  static s32 LoadFloatSingle(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands);
+  static s32 LoadFloatSingle(std::ostream& stream, const LoadStoreOperands& operands);
+  static s32 StoreFloatSingle(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands);
+  static s32 StoreFloatSingle(std::ostream& stream, const LoadStoreOperands& operands);
+  static s32 LoadPairedQuantized(PowerPC::PowerPCState& ppc_state,
+                                 const PairedLoadStoreOperands& operands);
+  static s32 LoadPairedQuantized(std::ostream& stream, const PairedLoadStoreOperands& operands);
+  static s32 StorePairedQuantized(PowerPC::PowerPCState& ppc_state,
+                                  const PairedLoadStoreOperands& operands);
+  static s32 StorePairedQuantized(std::ostream& stream, const PairedLoadStoreOperands& operands);
+
+  // [emubench] Fused instructions (see CachedInterpreter_Instructions.cpp)
+  template <bool is_signed, bool is_immediate>
+  static s32 CompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                              const CompareAndBranchOperands& operands);
+  template <bool is_signed, bool is_immediate>
+  static s32 CompareAndBranch(std::ostream& stream, const CompareAndBranchOperands& operands);
+  template <bool is_signed>
+  static s32 RotateMaskAndCompare(PowerPC::PowerPCState& ppc_state,
+                                  const RotateMaskCompareOperands& operands);
+  template <bool is_signed>
+  static s32 RotateMaskAndCompare(std::ostream& stream, const RotateMaskCompareOperands& operands);
+
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges;
   CachedInterpreterBlockCache m_block_cache;
 };
@@ -136,6 +227,16 @@ struct CachedInterpreter::EndBlockOperands<true> : CachedInterpreter::EndBlockOp
   JitBlock::ProfileData* profile_data;
 };
 
+// [emubench] CachedInterpreterBlockCache::WriteLinkBlock rewrites `destination` in place, so it
+// must stay the first member.
+struct CachedInterpreter::LinkBlockOperands
+{
+  // Entry of the block at exit_address, or nullptr while this exit is unlinked
+  const u8* destination;
+  u32 exit_address;
+  CPUEmuFeatureFlags feature_flags;
+};
+
 struct CachedInterpreter::InterpretOperands
 {
   Interpreter& interpreter;
@@ -175,3 +276,81 @@ struct CachedInterpreter::CheckIdleOperands
   CoreTiming::CoreTimingManager& core_timing;
   u32 idle_pc;
 };
+
+struct CachedInterpreter::LoadImmediateOperands
+{
+  u32 rd;
+  u32 imm;
+};
+
+// Used by instructions of the form rD = rA <op> imm. The immediate is already sign-extended or
+// shifted as the instruction requires.
+struct CachedInterpreter::ImmediateOperands
+{
+  u32 rd;
+  u32 ra;
+  u32 imm;
+  u32 : 32;
+};
+
+struct CachedInterpreter::RotateMaskOperands
+{
+  u32 ra;
+  u32 rs;
+  u32 shift;
+  u32 mask;
+};
+
+// `b` is a register index for CompareRegister and the (extended) immediate for CompareImmediate.
+struct CachedInterpreter::CompareOperands
+{
+  u32 crf;
+  u32 ra;
+  u32 b;
+  u32 : 32;
+};
+
+// `reg` is the GPR or FPR being loaded or stored. The effective address is
+// (ra ? gpr[ra] : 0) + offset.
+struct CachedInterpreter::LoadStoreOperands
+{
+  PowerPC::MMU& mmu;
+  u32 reg;
+  u32 ra;
+  u32 offset;
+  u32 : 32;
+};
+
+struct CachedInterpreter::PairedLoadStoreOperands : LoadStoreOperands
+{
+  u32 gqr;
+  u32 w;
+};
+
+// cmp/cmpl/cmpi/cmpli followed by a bcx that tests a bit of the field just compared and doesn't
+// touch CTR. The branch is taken if (field & bit_mask) != 0 equals branch_if.
+struct CachedInterpreter::CompareAndBranchOperands
+{
+  Core::BranchWatch& branch_watch;
+  u32 crf;
+  u32 ra;
+  u32 b;
+  u32 bit_mask;
+  u32 branch_if;
+  u32 lk;
+  u32 branch_pc;
+  u32 target;
+  UGeckoInstruction inst;  // The bcx, for BranchWatch
+  u32 : 32;
+};
+
+// rlwinm (without record) followed by cmpi/cmpli on its result
+struct CachedInterpreter::RotateMaskCompareOperands
+{
+  u32 ra;
+  u32 rs;
+  u32 shift;
+  u32 mask;
+  u32 crf;
+  u32 imm;
+};
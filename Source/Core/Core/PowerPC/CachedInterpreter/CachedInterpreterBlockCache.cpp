@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreterBlockCache.h"
 
+#include <cstring>
+
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreterEmitter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
@@ -32,6 +34,9 @@ void CachedInterpreterBlockCache::ClearRangesToFree()
 void CachedInterpreterBlockCache::WriteLinkBlock(const JitBlock::LinkData& source,
                                                  const JitBlock* dest)
 {
+  // [emubench] exitPtrs points at the destination pointer of a LinkBlock callback's operands.
+  const u8* const destination = dest ? dest->normalEntry : nullptr;
+  std::memcpy(source.exitPtrs, &destination, sizeof(destination));
 }
 
 void CachedInterpreterBlockCache::WriteDestroyBlock(const JitBlock& block)
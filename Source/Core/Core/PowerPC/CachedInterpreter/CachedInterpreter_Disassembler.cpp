@@ -34,6 +34,30 @@ s32 CachedInterpreter::EndBlock(std::ostream& stream, const EndBlockOperands<pro
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
+template <bool profiled>
+s32 CachedInterpreter::EndBlockAndLink(std::ostream& stream,
+                                       const EndBlockOperands<profiled>& operands)
+{
+  fmt::println(stream,
+               "EndBlockAndLink<profiled={}>(downcount={}, num_load_stores={}, num_fp_inst={})",
+               profiled, operands.downcount, operands.num_load_stores, operands.num_fp_inst);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LinkBlock(std::ostream& stream, const LinkBlockOperands& operands)
+{
+  const auto& [destination, exit_address, feature_flags] = operands;
+  fmt::println(stream, "LinkBlock(exit_address=0x{:08x}, linked={})", exit_address,
+               destination != nullptr);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::ExitBlock(std::ostream& stream, const void* operands)
+{
+  stream << "ExitBlock()\n";
+  return sizeof(AnyCallback);
+}
+
 template <bool write_pc>
 s32 CachedInterpreter::Interpret(std::ostream& stream, const InterpretOperands& operands)
 {
@@ -90,6 +114,127 @@ s32 CachedInterpreter::CheckIdle(std::ostream& stream, const CheckIdleOperands&
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
+s32 CachedInterpreter::LoadImmediate(std::ostream& stream, const LoadImmediateOperands& operands)
+{
+  const auto& [rd, imm] = operands;
+  fmt::println(stream, "LoadImmediate(rd={}, imm=0x{:08x})", rd, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::AddImmediate(std::ostream& stream, const ImmediateOperands& operands)
+{
+  const auto& [rd, ra, imm] = operands;
+  fmt::println(stream, "AddImmediate(rd={}, ra={}, imm=0x{:08x})", rd, ra, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::OrImmediate(std::ostream& stream, const ImmediateOperands& operands)
+{
+  const auto& [ra, rs, imm] = operands;
+  fmt::println(stream, "OrImmediate(ra={}, rs={}, imm=0x{:08x})", ra, rs, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::RotateAndMask(std::ostream& stream, const RotateMaskOperands& operands)
+{
+  const auto& [ra, rs, shift, mask] = operands;
+  fmt::println(stream, "RotateAndMask(ra={}, rs={}, shift={}, mask=0x{:08x})", ra, rs, shift,
+               mask);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::CompareRegister(std::ostream& stream, const CompareOperands& operands)
+{
+  const auto& [crf, ra, rb] = operands;
+  fmt::println(stream, "CompareRegister<is_signed={:5}>(crf={}, ra={}, rb={})", is_signed, crf, ra,
+               rb);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::CompareImmediate(std::ostream& stream, const CompareOperands& operands)
+{
+  const auto& [crf, ra, imm] = operands;
+  fmt::println(stream, "CompareImmediate<is_signed={:5}>(crf={}, ra={}, imm=0x{:08x})", is_signed,
+               crf, ra, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <typename T>
+s32 CachedInterpreter::LoadGPR(std::ostream& stream, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, rd, ra, offset] = operands;
+  fmt::println(stream, "LoadGPR<size={}>(rd={}, ra={}, offset={})", sizeof(T), rd, ra,
+               static_cast<s32>(offset));
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <typename T>
+s32 CachedInterpreter::StoreGPR(std::ostream& stream, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, rs, ra, offset] = operands;
+  fmt::println(stream, "StoreGPR<size={}>(rs={}, ra={}, offset={})", sizeof(T), rs, ra,
+               static_cast<s32>(offset));
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LoadFloatSingle(std::ostream& stream, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, fd, ra, offset] = operands;
+  fmt::println(stream, "LoadFloatSingle(fd={}, ra={}, offset={})", fd, ra,
+               static_cast<s32>(offset));
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::StoreFloatSingle(std::ostream& stream, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, fs, ra, offset] = operands;
+  fmt::println(stream, "StoreFloatSingle(fs={}, ra={}, offset={})", fs, ra,
+               static_cast<s32>(offset));
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LoadPairedQuantized(std::ostream& stream,
+                                           const PairedLoadStoreOperands& operands)
+{
+  fmt::println(stream, "LoadPairedQuantized(fd={}, ra={}, offset={}, gqr={}, w={})", operands.reg,
+               operands.ra, static_cast<s32>(operands.offset), operands.gqr, operands.w);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::StorePairedQuantized(std::ostream& stream,
+                                            const PairedLoadStoreOperands& operands)
+{
+  fmt::println(stream, "StorePairedQuantized(fs={}, ra={}, offset={}, gqr={}, w={})", operands.reg,
+               operands.ra, static_cast<s32>(operands.offset), operands.gqr, operands.w);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed, bool is_immediate>
+s32 CachedInterpreter::CompareAndBranch(std::ostream& stream,
+                                        const CompareAndBranchOperands& operands)
+{
+  fmt::println(stream,
+               "CompareAndBranch<is_signed={:5}, is_immediate={:5}>(crf={}, ra={}, b=0x{:08x}, "
+               "bit_mask={}, branch_if={}, lk={}, branch_pc=0x{:08x}, target=0x{:08x})",
+               is_signed, is_immediate, operands.crf, operands.ra, operands.b, operands.bit_mask,
+               operands.branch_if, operands.lk, operands.branch_pc, operands.target);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::RotateMaskAndCompare(std::ostream& stream,
+                                            const RotateMaskCompareOperands& operands)
+{
+  const auto& [ra, rs, shift, mask, crf, imm] = operands;
+  fmt::println(stream,
+               "RotateMaskAndCompare<is_signed={:5}>(ra={}, rs={}, shift={}, mask=0x{:08x}, "
+               "crf={}, imm=0x{:08x})",
+               is_signed, ra, rs, shift, mask, crf, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
 static std::once_flag s_sorted_lookup_flag;
 
 std::size_t CachedInterpreter::Disassemble(const JitBlock& block, std::ostream& stream)
@@ -106,6 +251,10 @@ std::size_t CachedInterpreter::Disassemble(const JitBlock& block, std::ostream&
       LOOKUP_KV(CachedInterpreter::StartProfiledBlock),
       LOOKUP_KV(CachedInterpreter::EndBlock<false>),
       LOOKUP_KV(CachedInterpreter::EndBlock<true>),
+      LOOKUP_KV(CachedInterpreter::EndBlockAndLink<false>),
+      LOOKUP_KV(CachedInterpreter::EndBlockAndLink<true>),
+      LOOKUP_KV(CachedInterpreter::LinkBlock),
+      LOOKUP_KV(CachedInterpreter::ExitBlock),
       LOOKUP_KV(CachedInterpreter::Interpret<false>),
       LOOKUP_KV(CachedInterpreter::Interpret<true>),
       LOOKUP_KV(CachedInterpreter::InterpretAndCheckExceptions<false>),
@@ -115,6 +264,30 @@ std::size_t CachedInterpreter::Disassemble(const JitBlock& block, std::ostream&
       LOOKUP_KV(CachedInterpreter::CheckFPU),
       LOOKUP_KV(CachedInterpreter::CheckBreakpoint),
       LOOKUP_KV(CachedInterpreter::CheckIdle),
+      LOOKUP_KV(CachedInterpreter::LoadImmediate),
+      LOOKUP_KV(CachedInterpreter::AddImmediate),
+      LOOKUP_KV(CachedInterpreter::OrImmediate),
+      LOOKUP_KV(CachedInterpreter::RotateAndMask),
+      LOOKUP_KV(CachedInterpreter::CompareRegister<false>),
+      LOOKUP_KV(CachedInterpreter::CompareRegister<true>),
+      LOOKUP_KV(CachedInterpreter::CompareImmediate<false>),
+      LOOKUP_KV(CachedInterpreter::CompareImmediate<true>),
+      LOOKUP_KV(CachedInterpreter::LoadGPR<u8>),
+      LOOKUP_KV(CachedInterpreter::LoadGPR<u16>),
+      LOOKUP_KV(CachedInterpreter::LoadGPR<u32>),
+      LOOKUP_KV(CachedInterpreter::StoreGPR<u8>),
+      LOOKUP_KV(CachedInterpreter::StoreGPR<u16>),
+      LOOKUP_KV(CachedInterpreter::StoreGPR<u32>),
+      LOOKUP_KV(CachedInterpreter::LoadFloatSingle),
+      LOOKUP_KV(CachedInterpreter::StoreFloatSingle),
+      LOOKUP_KV(CachedInterpreter::LoadPairedQuantized),
+      LOOKUP_KV(CachedInterpreter::StorePairedQuantized),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<false, false>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<false, true>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<true, false>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<true, true>),
+      LOOKUP_KV(CachedInterpreter::RotateMaskAndCompare<false>),
+      LOOKUP_KV(CachedInterpreter::RotateMaskAndCompare<true>),
   });
 
 #undef LOOKUP_KV
@@ -0,0 +1,435 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+
+#include <bit>
+#include <optional>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Core/Debugger/BranchWatch.h"
+#include "Core/HLE/HLE.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/ExceptionUtils.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PowerPC.h"
+
+// [emubench]
+// These callbacks mirror their Interpreter counterparts, but take the instruction's fields from
+// operands decoded once at block compile time instead of going through the Interpreter's opcode
+// tables and decoding UGeckoInstruction on every execution. Exceptions are raised the same way the
+// Interpreter raises them, so they are only used where Interpret<false> would have been.
+
+static u32 GetEffectiveAddress(const PowerPC::PowerPCState& ppc_state, u32 ra, u32 offset)
+{
+  return ra ? ppc_state.gpr[ra] + offset : offset;
+}
+
+s32 CachedInterpreter::LoadImmediate(PowerPC::PowerPCState& ppc_state,
+                                     const LoadImmediateOperands& operands)
+{
+  const auto& [rd, imm] = operands;
+  ppc_state.gpr[rd] = imm;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::AddImmediate(PowerPC::PowerPCState& ppc_state,
+                                    const ImmediateOperands& operands)
+{
+  const auto& [rd, ra, imm] = operands;
+  ppc_state.gpr[rd] = ppc_state.gpr[ra] + imm;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::OrImmediate(PowerPC::PowerPCState& ppc_state,
+                                   const ImmediateOperands& operands)
+{
+  const auto& [ra, rs, imm] = operands;
+  ppc_state.gpr[ra] = ppc_state.gpr[rs] | imm;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::RotateAndMask(PowerPC::PowerPCState& ppc_state,
+                                     const RotateMaskOperands& operands)
+{
+  const auto& [ra, rs, shift, mask] = operands;
+  ppc_state.gpr[ra] = std::rotl(ppc_state.gpr[rs], shift) & mask;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+static u32 CompareAndSetCR(PowerPC::PowerPCState& ppc_state, u32 crf, u32 a, u32 b)
+{
+  using T = std::conditional_t<is_signed, s32, u32>;
+  const T lhs = static_cast<T>(a);
+  const T rhs = static_cast<T>(b);
+
+  u32 cr_field;
+  if (lhs < rhs)
+    cr_field = PowerPC::CR_LT;
+  else if (lhs > rhs)
+    cr_field = PowerPC::CR_GT;
+  else
+    cr_field = PowerPC::CR_EQ;
+
+  if (ppc_state.GetXER_SO())
+    cr_field |= PowerPC::CR_SO;
+
+  ppc_state.cr.SetField(crf, cr_field);
+  return cr_field;
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::CompareRegister(PowerPC::PowerPCState& ppc_state,
+                                       const CompareOperands& operands)
+{
+  const auto& [crf, ra, rb] = operands;
+  CompareAndSetCR<is_signed>(ppc_state, crf, ppc_state.gpr[ra], ppc_state.gpr[rb]);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::CompareImmediate(PowerPC::PowerPCState& ppc_state,
+                                        const CompareOperands& operands)
+{
+  const auto& [crf, ra, imm] = operands;
+  CompareAndSetCR<is_signed>(ppc_state, crf, ppc_state.gpr[ra], imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <typename T>
+s32 CachedInterpreter::LoadGPR(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, rd, ra, offset] = operands;
+  const u32 address = GetEffectiveAddress(ppc_state, ra, offset);
+
+  u32 temp;
+  if constexpr (std::is_same_v<T, u8>)
+    temp = mmu.Read_U8(address);
+  else if constexpr (std::is_same_v<T, u16>)
+    temp = mmu.Read_U16(address);
+  else
+    temp = mmu.Read_U32(address);
+
+  if (!(ppc_state.Exceptions & EXCEPTION_DSI))
+    ppc_state.gpr[rd] = temp;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <typename T>
+s32 CachedInterpreter::StoreGPR(PowerPC::PowerPCState& ppc_state, const LoadStoreOperands& operands)
+{
+  const auto& [mmu, rs, ra, offset] = operands;
+  const u32 address = GetEffectiveAddress(ppc_state, ra, offset);
+
+  if constexpr (std::is_same_v<T, u8>)
+    mmu.Write_U8(ppc_state.gpr[rs], address);
+  else if constexpr (std::is_same_v<T, u16>)
+    mmu.Write_U16(ppc_state.gpr[rs], address);
+  else
+    mmu.Write_U32(ppc_state.gpr[rs], address);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LoadFloatSingle(PowerPC::PowerPCState& ppc_state,
+                                       const LoadStoreOperands& operands)
+{
+  const auto& [mmu, fd, ra, offset] = operands;
+  const u32 address = GetEffectiveAddress(ppc_state, ra, offset);
+
+  if ((address & 0b11) != 0)
+  {
+    GenerateAlignmentException(ppc_state, address);
+    return sizeof(AnyCallback) + sizeof(operands);
+  }
+
+  const u32 temp = mmu.Read_U32(address);
+  if (!(ppc_state.Exceptions & EXCEPTION_DSI))
+    ppc_state.ps[fd].Fill(ConvertToDouble(temp));
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::StoreFloatSingle(PowerPC::PowerPCState& ppc_state,
+                                        const LoadStoreOperands& operands)
+{
+  const auto& [mmu, fs, ra, offset] = operands;
+  const u32 address = GetEffectiveAddress(ppc_state, ra, offset);
+
+  if ((address & 0b11) != 0)
+  {
+    GenerateAlignmentException(ppc_state, address);
+    return sizeof(AnyCallback) + sizeof(operands);
+  }
+
+  mmu.Write_U32(ConvertToSingle(ppc_state.ps[fs].PS0AsU64()), address);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LoadPairedQuantized(PowerPC::PowerPCState& ppc_state,
+                                           const PairedLoadStoreOperands& operands)
+{
+  if (HID2(ppc_state).LSQE == 0)
+  {
+    GenerateProgramException(ppc_state, ProgramExceptionCause::IllegalInstruction);
+    return sizeof(AnyCallback) + sizeof(operands);
+  }
+
+  const u32 address = GetEffectiveAddress(ppc_state, operands.ra, operands.offset);
+  Interpreter::LoadPairedQuantized(operands.mmu, ppc_state, address, operands.gqr, operands.reg,
+                                   operands.w);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::StorePairedQuantized(PowerPC::PowerPCState& ppc_state,
+                                            const PairedLoadStoreOperands& operands)
+{
+  if (HID2(ppc_state).LSQE == 0)
+  {
+    GenerateProgramException(ppc_state, ProgramExceptionCause::IllegalInstruction);
+    return sizeof(AnyCallback) + sizeof(operands);
+  }
+
+  const u32 address = GetEffectiveAddress(ppc_state, operands.ra, operands.offset);
+  Interpreter::StorePairedQuantized(operands.mmu, ppc_state, address, operands.gqr, operands.reg,
+                                    operands.w);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed, bool is_immediate>
+s32 CachedInterpreter::CompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                        const CompareAndBranchOperands& operands)
+{
+  const u32 b = is_immediate ? operands.b : ppc_state.gpr[operands.b];
+  const u32 cr_field =
+      CompareAndSetCR<is_signed>(ppc_state, operands.crf, ppc_state.gpr[operands.ra], b);
+
+  // Like Interpret<true> would for the branch
+  ppc_state.pc = operands.branch_pc;
+  if (u32((cr_field & operands.bit_mask) != 0) == operands.branch_if)
+  {
+    if (operands.lk)
+      LR(ppc_state) = operands.branch_pc + 4;
+    ppc_state.npc = operands.target;
+    if (operands.branch_watch.GetRecordingActive())
+    {
+      operands.branch_watch.HitTrue(operands.branch_pc, operands.target, operands.inst,
+                                    ppc_state.msr.IR);
+    }
+  }
+  else
+  {
+    ppc_state.npc = operands.branch_pc + 4;
+    if (operands.branch_watch.GetRecordingActive())
+    {
+      operands.branch_watch.HitFalse(operands.branch_pc, operands.branch_pc + 4, operands.inst,
+                                     ppc_state.msr.IR);
+    }
+  }
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed>
+s32 CachedInterpreter::RotateMaskAndCompare(PowerPC::PowerPCState& ppc_state,
+                                            const RotateMaskCompareOperands& operands)
+{
+  const auto& [ra, rs, shift, mask, crf, imm] = operands;
+  const u32 result = std::rotl(ppc_state.gpr[rs], shift) & mask;
+  ppc_state.gpr[ra] = result;
+  CompareAndSetCR<is_signed>(ppc_state, crf, result, imm);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+bool CachedInterpreter::WriteSpecializedInstruction(const PPCAnalyst::CodeOp& op)
+{
+  if (bJITOff)
+    return false;
+
+  const UGeckoInstruction inst = op.inst;
+
+  const auto write_load_store = [&](Callback<LoadStoreOperands> callback, bool disabled) {
+    if (disabled)
+      return false;
+    Write(callback, LoadStoreOperands{m_mmu, inst.RD, inst.RA, u32(inst.SIMM_16)});
+    return true;
+  };
+  const auto write_paired = [&](Callback<PairedLoadStoreOperands> callback) {
+    if (bJITLoadStorePairedOff)
+      return false;
+    Write(callback, PairedLoadStoreOperands{{m_mmu, inst.RD, inst.RA, u32(inst.SIMM_12)},
+                                            inst.I,
+                                            inst.W});
+    return true;
+  };
+
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+  case 15:  // addis
+  {
+    if (bJITIntegerOff)
+      return false;
+    const u32 imm = inst.OPCD == 14 ? u32(inst.SIMM_16) : u32(inst.SIMM_16 << 16);
+    if (inst.RA == 0)
+      Write(LoadImmediate, {inst.RD, imm});
+    else
+      Write(AddImmediate, {inst.RD, inst.RA, imm});
+    return true;
+  }
+  case 24:  // ori
+  case 25:  // oris
+  {
+    if (bJITIntegerOff)
+      return false;
+    const u32 imm = inst.OPCD == 24 ? u32{inst.UIMM} : u32{inst.UIMM} << 16;
+    Write(OrImmediate, {inst.RA, inst.RS, imm});
+    return true;
+  }
+  case 21:  // rlwinmx
+    // The record form also updates CR0; leave that to the Interpreter.
+    if (bJITIntegerOff || inst.Rc)
+      return false;
+    Write(RotateAndMask, {inst.RA, inst.RS, inst.SH, MakeRotationMask(inst.MB, inst.ME)});
+    return true;
+  case 10:  // cmpli
+    if (bJITIntegerOff)
+      return false;
+    Write(CompareImmediate<false>, {inst.CRFD, inst.RA, u32{inst.UIMM}});
+    return true;
+  case 11:  // cmpi
+    if (bJITIntegerOff)
+      return false;
+    Write(CompareImmediate<true>, {inst.CRFD, inst.RA, u32(inst.SIMM_16)});
+    return true;
+  case 31:
+    if (bJITIntegerOff || (inst.SUBOP10 != 0 && inst.SUBOP10 != 32))
+      return false;
+    // cmp or cmpl
+    Write(inst.SUBOP10 == 0 ? CallbackCast(CompareRegister<true>) :
+                              CallbackCast(CompareRegister<false>),
+          {inst.CRFD, inst.RA, inst.RB});
+    return true;
+  case 32:  // lwz
+    return write_load_store(LoadGPR<u32>, bJITLoadStoreOff || bJITLoadStorelwzOff);
+  case 34:  // lbz
+    return write_load_store(LoadGPR<u8>, bJITLoadStoreOff || bJITLoadStorelXzOff);
+  case 40:  // lhz
+    return write_load_store(LoadGPR<u16>, bJITLoadStoreOff || bJITLoadStorelXzOff);
+  case 36:  // stw
+    return write_load_store(StoreGPR<u32>, bJITLoadStoreOff);
+  case 38:  // stb
+    return write_load_store(StoreGPR<u8>, bJITLoadStoreOff);
+  case 44:  // sth
+    return write_load_store(StoreGPR<u16>, bJITLoadStoreOff);
+  case 48:  // lfs
+    return write_load_store(LoadFloatSingle, bJITLoadStoreFloatingOff);
+  case 52:  // stfs
+    return write_load_store(StoreFloatSingle, bJITLoadStoreFloatingOff);
+  case 56:  // psq_l
+    return write_paired(LoadPairedQuantized);
+  case 60:  // psq_st
+    return write_paired(StorePairedQuantized);
+  default:
+    return false;
+  }
+}
+
+std::optional<u32> CachedInterpreter::GetFusedLoadImmediate(UGeckoInstruction inst,
+                                                           UGeckoInstruction next_inst)
+{
+  // lis rD, hi followed by addi rD, rD, lo or ori rD, rD, lo
+  if (inst.OPCD != 15 || inst.RA != 0)
+    return std::nullopt;
+
+  const u32 hi = u32(inst.SIMM_16 << 16);
+  // addi reads the literal 0 instead of r0, so lis r0 + addi r0, r0 isn't a pair
+  if (next_inst.OPCD == 14 && inst.RD != 0 && next_inst.RD == inst.RD && next_inst.RA == inst.RD)
+    return hi + u32(next_inst.SIMM_16);
+  if (next_inst.OPCD == 24 && next_inst.RS == inst.RD && next_inst.RA == inst.RD)
+    return hi | next_inst.UIMM;
+  return std::nullopt;
+}
+
+bool CachedInterpreter::WriteFusedInstructions(const PPCAnalyst::CodeOp& op,
+                                               const PPCAnalyst::CodeOp& next)
+{
+  // Breakpoints and HLE hooks need a callback boundary at `next`.
+  if (bJITOff || bJITIntegerOff || IsDebuggingEnabled() || next.skip ||
+      HLE::TryReplaceFunction(m_ppc_symbol_db, next.address, PowerPC::CoreMode::JIT))
+  {
+    return false;
+  }
+
+  const UGeckoInstruction inst = op.inst;
+  const UGeckoInstruction next_inst = next.inst;
+
+  if (const std::optional<u32> imm = GetFusedLoadImmediate(inst, next_inst))
+  {
+    Write(LoadImmediate, {inst.RD, *imm});
+    return true;
+  }
+
+  const bool is_compare_immediate = inst.OPCD == 10 || inst.OPCD == 11;
+  const bool is_compare_register = inst.OPCD == 31 && (inst.SUBOP10 == 0 || inst.SUBOP10 == 32);
+
+  // cmp* crfD, ... followed by bc on a bit of crfD that doesn't decrement CTR
+  if ((is_compare_immediate || is_compare_register) && next_inst.OPCD == 16 &&
+      (next_inst.BO & BO_DONT_DECREMENT_FLAG) != 0 &&
+      (next_inst.BO & BO_DONT_CHECK_CONDITION) == 0 && next_inst.BI / 4 == inst.CRFD &&
+      !bJITBranchOff)
+  {
+    const bool is_signed = inst.OPCD == 11 || (inst.OPCD == 31 && inst.SUBOP10 == 0);
+    u32 b;
+    if (is_compare_register)
+      b = inst.RB;
+    else
+      b = is_signed ? u32(inst.SIMM_16) : u32{inst.UIMM};
+
+    const CompareAndBranchOperands operands = {m_branch_watch,
+                                               inst.CRFD,
+                                               inst.RA,
+                                               b,
+                                               u32{8} >> (next_inst.BI & 3),
+                                               (next_inst.BO >> 3) & 1,
+                                               next_inst.LK,
+                                               next.address,
+                                               next.branchTo,
+                                               next_inst};
+    if (is_compare_immediate)
+    {
+      Write(is_signed ? CallbackCast(CompareAndBranch<true, true>) :
+                        CallbackCast(CompareAndBranch<false, true>),
+            operands);
+    }
+    else
+    {
+      Write(is_signed ? CallbackCast(CompareAndBranch<true, false>) :
+                        CallbackCast(CompareAndBranch<false, false>),
+            operands);
+    }
+    return true;
+  }
+
+  // rlwinm rA, rS, ... followed by cmpi/cmpli crfD, rA, imm
+  if (inst.OPCD == 21 && !inst.Rc && (next_inst.OPCD == 10 || next_inst.OPCD == 11) &&
+      next_inst.RA == inst.RA)
+  {
+    const u32 mask = MakeRotationMask(inst.MB, inst.ME);
+    if (next_inst.OPCD == 11)
+    {
+      Write(RotateMaskAndCompare<true>,
+            {inst.RA, inst.RS, inst.SH, mask, next_inst.CRFD, u32(next_inst.SIMM_16)});
+    }
+    else
+    {
+      Write(RotateMaskAndCompare<false>,
+            {inst.RA, inst.RS, inst.SH, mask, next_inst.CRFD, u32{next_inst.UIMM}});
+    }
+    return true;
+  }
+
+  return false;
+}
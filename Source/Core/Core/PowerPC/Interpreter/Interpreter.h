@@ -294,6 +294,13 @@ public:
 
   static u32 Helper_Carry(u32 value1, u32 value2);
 
+  // [emubench] Quantized paired single transfers with the instruction fields already decoded, for
+  // the Cached Interpreter. Neither checks HID2.LSQE.
+  static void LoadPairedQuantized(PowerPC::MMU& mmu, PowerPC::PowerPCState& ppc_state, u32 address,
+                                  u32 gqr, u32 fd, u32 w);
+  static void StorePairedQuantized(PowerPC::MMU& mmu, const PowerPC::PowerPCState& ppc_state,
+                                   u32 address, u32 gqr, u32 fs, u32 w);
+
 private:
   void CheckExceptions();
 
@@ -14,6 +14,7 @@
 #include "Common/MathUtil.h"
 #include "Core/PowerPC/Interpreter/ExceptionUtils.h"
 #include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/Interpreter/Interpreter_PairedSIMD.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -160,16 +161,25 @@ void QuantizeAndStore(PowerPC::MMU& mmu, double ps0, double ps1, u32 addr, u32 i
 {
   using U = std::make_unsigned_t<T>;
 
-  const U conv_ps0 = U(ScaleAndClamp<T>(ps0, st_scale));
   if (instW)
   {
-    WriteUnpaired<U>(mmu, conv_ps0, addr);
+    WriteUnpaired<U>(mmu, U(ScaleAndClamp<T>(ps0, st_scale)), addr);
+    return;
   }
-  else
+
+#ifdef PAIRED_SIMD_AVAILABLE
+  constexpr float min = float(std::numeric_limits<T>::min());
+  constexpr float max = float(std::numeric_limits<T>::max());
+  if (const auto conv = PairedSIMD::Quantize(ps0, ps1, m_quantizeTable[st_scale], min, max))
   {
-    const U conv_ps1 = U(ScaleAndClamp<T>(ps1, st_scale));
-    WritePair<U>(mmu, conv_ps0, conv_ps1, addr);
+    WritePair<U>(mmu, U(T(conv->first)), U(T(conv->second)), addr);
+    return;
   }
+#endif
+
+  const U conv_ps0 = U(ScaleAndClamp<T>(ps0, st_scale));
+  const U conv_ps1 = U(ScaleAndClamp<T>(ps1, st_scale));
+  WritePair<U>(mmu, conv_ps0, conv_ps1, addr);
 }
 
 static void Helper_Quantize(PowerPC::MMU& mmu, const PowerPC::PowerPCState* ppcs, u32 addr,
@@ -242,8 +252,13 @@ std::pair<double, double> LoadAndDequantize(PowerPC::MMU& mmu, u32 addr, u32 ins
   else
   {
     const auto [first, second] = ReadPair<U>(mmu, addr);
+#ifdef PAIRED_SIMD_AVAILABLE
+    const auto values = PairedSIMD::Dequantize(T(first), T(second), m_dequantizeTable[ld_scale]);
+    return {PairedSIMD::Lane0(values), PairedSIMD::Lane1(values)};
+#else
     ps0 = float(T(first)) * m_dequantizeTable[ld_scale];
     ps1 = float(T(second)) * m_dequantizeTable[ld_scale];
+#endif
   }
   // ps0 and ps1 always contain finite and normal numbers. So we can just cast them to double
   return {static_cast<double>(ps0), static_cast<double>(ps1)};
@@ -309,6 +324,18 @@ static void Helper_Dequantize(PowerPC::MMU& mmu, PowerPC::PowerPCState* ppcs, u3
   ppcs->ps[instRD].SetBoth(ps0, ps1);
 }
 
+void Interpreter::LoadPairedQuantized(PowerPC::MMU& mmu, PowerPC::PowerPCState& ppc_state,
+                                      u32 address, u32 gqr, u32 fd, u32 w)
+{
+  Helper_Dequantize(mmu, &ppc_state, address, gqr, fd, w);
+}
+
+void Interpreter::StorePairedQuantized(PowerPC::MMU& mmu, const PowerPC::PowerPCState& ppc_state,
+                                       u32 address, u32 gqr, u32 fs, u32 w)
+{
+  Helper_Quantize(mmu, &ppc_state, address, gqr, fs, w);
+}
+
 void Interpreter::psq_l(Interpreter& interpreter, UGeckoInstruction inst)
 {
   auto& ppc_state = interpreter.m_ppc_state;
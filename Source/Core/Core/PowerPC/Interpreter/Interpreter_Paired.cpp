@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/FloatUtils.h"
 #include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/Interpreter/Interpreter_PairedSIMD.h"
 #include "Core/PowerPC/PowerPC.h"
 
 // These "binary instructions" do not alter FPSCR.
@@ -18,8 +19,14 @@ void Interpreter::ps_sel(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result =
+      PairedSIMD::Select(PairedSIMD::Load(a), PairedSIMD::Load(c), PairedSIMD::Load(b));
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(a.PS0AsDouble() >= -0.0 ? c.PS0AsDouble() : b.PS0AsDouble(),
                                 a.PS1AsDouble() >= -0.0 ? c.PS1AsDouble() : b.PS1AsDouble());
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -30,8 +37,13 @@ void Interpreter::ps_neg(Interpreter& interpreter, UGeckoInstruction inst)
   auto& ppc_state = interpreter.m_ppc_state;
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::BitXor(PairedSIMD::Load(b), Common::DOUBLE_SIGN);
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(b.PS0AsU64() ^ (UINT64_C(1) << 63),
                                 b.PS1AsU64() ^ (UINT64_C(1) << 63));
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -51,8 +63,13 @@ void Interpreter::ps_nabs(Interpreter& interpreter, UGeckoInstruction inst)
   auto& ppc_state = interpreter.m_ppc_state;
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::BitOr(PairedSIMD::Load(b), Common::DOUBLE_SIGN);
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(b.PS0AsU64() | (UINT64_C(1) << 63),
                                 b.PS1AsU64() | (UINT64_C(1) << 63));
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -63,8 +80,13 @@ void Interpreter::ps_abs(Interpreter& interpreter, UGeckoInstruction inst)
   auto& ppc_state = interpreter.m_ppc_state;
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::BitAnd(PairedSIMD::Load(b), ~Common::DOUBLE_SIGN);
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(b.PS0AsU64() & ~(UINT64_C(1) << 63),
                                 b.PS1AsU64() & ~(UINT64_C(1) << 63));
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -77,7 +99,12 @@ void Interpreter::ps_merge00(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::Merge<0, 0>(PairedSIMD::Load(a), PairedSIMD::Load(b));
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(a.PS0AsDouble(), b.PS0AsDouble());
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -89,7 +116,12 @@ void Interpreter::ps_merge01(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::Merge<0, 1>(PairedSIMD::Load(a), PairedSIMD::Load(b));
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(a.PS0AsDouble(), b.PS1AsDouble());
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -101,7 +133,12 @@ void Interpreter::ps_merge10(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::Merge<1, 0>(PairedSIMD::Load(a), PairedSIMD::Load(b));
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(a.PS1AsDouble(), b.PS0AsDouble());
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -113,7 +150,12 @@ void Interpreter::ps_merge11(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  const auto result = PairedSIMD::Merge<1, 1>(PairedSIMD::Load(a), PairedSIMD::Load(b));
+  PairedSIMD::Store(ppc_state.ps[inst.FD], result);
+#else
   ppc_state.ps[inst.FD].SetBoth(a.PS1AsDouble(), b.PS1AsDouble());
+#endif
 
   if (inst.Rc)
     ppc_state.UpdateCR1();
@@ -126,6 +168,16 @@ void Interpreter::ps_div(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Div>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                                   PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const float ps0 =
       ForceSingle(ppc_state.fpscr, NI_div(ppc_state, a.PS0AsDouble(), b.PS0AsDouble()).value);
   const float ps1 =
@@ -207,6 +259,16 @@ void Interpreter::ps_sub(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Sub>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                                   PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const float ps0 =
       ForceSingle(ppc_state.fpscr, NI_sub(ppc_state, a.PS0AsDouble(), b.PS0AsDouble()).value);
   const float ps1 =
@@ -225,6 +287,16 @@ void Interpreter::ps_add(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& b = ppc_state.ps[inst.FB];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Add>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                                   PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const float ps0 =
       ForceSingle(ppc_state.fpscr, NI_add(ppc_state, a.PS0AsDouble(), b.PS0AsDouble()).value);
   const float ps1 =
@@ -243,6 +315,16 @@ void Interpreter::ps_mul(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Mul>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                                   PairedSIMD::Force25BitPair(c)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const double c1 = Force25Bit(c.PS1AsDouble());
 
@@ -263,6 +345,16 @@ void Interpreter::ps_msub(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<true, false>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                       PairedSIMD::Force25BitPair(c), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const double c1 = Force25Bit(c.PS1AsDouble());
 
@@ -285,6 +377,16 @@ void Interpreter::ps_madd(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<false, false>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                        PairedSIMD::Force25BitPair(c), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const double c1 = Force25Bit(c.PS1AsDouble());
 
@@ -307,6 +409,16 @@ void Interpreter::ps_nmsub(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<true, true>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                      PairedSIMD::Force25BitPair(c), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const double c1 = Force25Bit(c.PS1AsDouble());
 
@@ -332,6 +444,16 @@ void Interpreter::ps_nmadd(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<false, true>(ppc_state, inst.FD, PairedSIMD::Load(a),
+                                       PairedSIMD::Force25BitPair(c), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const double c1 = Force25Bit(c.PS1AsDouble());
 
@@ -392,6 +514,17 @@ void Interpreter::ps_muls0(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Mul>(
+          ppc_state, inst.FD, PairedSIMD::Load(a),
+          PairedSIMD::Force25BitBroadcast(c.PS0AsDouble())))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const float ps0 = ForceSingle(ppc_state.fpscr, NI_mul(ppc_state, a.PS0AsDouble(), c0).value);
   const float ps1 = ForceSingle(ppc_state.fpscr, NI_mul(ppc_state, a.PS1AsDouble(), c0).value);
@@ -409,6 +542,17 @@ void Interpreter::ps_muls1(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& a = ppc_state.ps[inst.FA];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryArith<PairedSIMD::Arith::Mul>(
+          ppc_state, inst.FD, PairedSIMD::Load(a),
+          PairedSIMD::Force25BitBroadcast(c.PS1AsDouble())))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c1 = Force25Bit(c.PS1AsDouble());
   const float ps0 = ForceSingle(ppc_state.fpscr, NI_mul(ppc_state, a.PS0AsDouble(), c1).value);
   const float ps1 = ForceSingle(ppc_state.fpscr, NI_mul(ppc_state, a.PS1AsDouble(), c1).value);
@@ -427,6 +571,17 @@ void Interpreter::ps_madds0(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<false, false>(
+          ppc_state, inst.FD, PairedSIMD::Load(a),
+          PairedSIMD::Force25BitBroadcast(c.PS0AsDouble()), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c0 = Force25Bit(c.PS0AsDouble());
   const float ps0 =
       ForceSingle(ppc_state.fpscr, NI_madd(ppc_state, a.PS0AsDouble(), c0, b.PS0AsDouble()).value);
@@ -447,6 +602,17 @@ void Interpreter::ps_madds1(Interpreter& interpreter, UGeckoInstruction inst)
   const auto& b = ppc_state.ps[inst.FB];
   const auto& c = ppc_state.ps[inst.FC];
 
+#ifdef PAIRED_SIMD_AVAILABLE
+  if (PairedSIMD::TryMAdd<false, false>(
+          ppc_state, inst.FD, PairedSIMD::Load(a),
+          PairedSIMD::Force25BitBroadcast(c.PS1AsDouble()), PairedSIMD::Load(b)))
+  {
+    if (inst.Rc)
+      ppc_state.UpdateCR1();
+    return;
+  }
+#endif
+
   const double c1 = Force25Bit(c.PS1AsDouble());
   const float ps0 =
       ForceSingle(ppc_state.fpscr, NI_madd(ppc_state, a.PS0AsDouble(), c1, b.PS0AsDouble()).value);
@@ -0,0 +1,442 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// [emubench] 128-bit kernels that run both slots of a paired-single instruction at once.
+//
+// The kernels only cover the common case. Results that are NaN (or infinite, for divisions) and
+// inputs that are infinite make them return false without touching any state. The caller then
+// runs the scalar helpers in Interpreter_FPUtils.h, which raise the FPSCR exceptions and propagate
+// NaNs. Otherwise the vector and scalar paths do the same IEEE operations under the same host
+// rounding mode and denormal flags, so the results are bit-identical.
+//
+// This checks the compiler's target macros rather than _M_X86_64 and _M_ARM_64, so that generic
+// builds, which have no JIT to fall back to, get the vector paths too.
+
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define PAIRED_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PAIRED_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace PairedSIMD
+{
+#if defined(PAIRED_SIMD_SSE2)
+
+#if defined(__FMA__)
+#define PAIRED_SIMD_TARGET_FMA
+inline bool HasFMA()
+{
+  return true;
+}
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define PAIRED_SIMD_TARGET_FMA [[gnu::target("fma")]]
+#else
+#define PAIRED_SIMD_TARGET_FMA
+#endif
+inline bool HasFMA()
+{
+  return cpu_info.bFMA;
+}
+#endif
+
+using Vec = __m128d;
+
+inline Vec Load(const PowerPC::PairedSingle& ps)
+{
+  return _mm_loadu_pd(reinterpret_cast<const double*>(&ps));
+}
+
+inline void Store(PowerPC::PairedSingle& ps, Vec v)
+{
+  _mm_storeu_pd(reinterpret_cast<double*>(&ps), v);
+}
+
+inline Vec Make(double ps0, double ps1)
+{
+  return _mm_set_pd(ps1, ps0);
+}
+
+inline double Lane0(Vec v)
+{
+  return _mm_cvtsd_f64(v);
+}
+
+inline double Lane1(Vec v)
+{
+  return _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));
+}
+
+// Slot A of `a` and slot B of `b`
+template <int A, int B>
+inline Vec Merge(Vec a, Vec b)
+{
+  return _mm_shuffle_pd(a, b, A | (B << 1));
+}
+
+inline Vec Add(Vec a, Vec b)
+{
+  return _mm_add_pd(a, b);
+}
+
+inline Vec Sub(Vec a, Vec b)
+{
+  return _mm_sub_pd(a, b);
+}
+
+inline Vec Mul(Vec a, Vec b)
+{
+  return _mm_mul_pd(a, b);
+}
+
+inline Vec Div(Vec a, Vec b)
+{
+  return _mm_div_pd(a, b);
+}
+
+// Fused a * c + b and a * c - b. Only call these if HasFMA().
+PAIRED_SIMD_TARGET_FMA inline Vec MAdd(Vec a, Vec c, Vec b)
+{
+  return _mm_fmadd_pd(a, c, b);
+}
+
+PAIRED_SIMD_TARGET_FMA inline Vec MSub(Vec a, Vec c, Vec b)
+{
+  return _mm_fmsub_pd(a, c, b);
+}
+
+inline Vec BitXor(Vec a, u64 mask)
+{
+  return _mm_xor_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(mask)));
+}
+
+inline Vec BitOr(Vec a, u64 mask)
+{
+  return _mm_or_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(mask)));
+}
+
+inline Vec BitAnd(Vec a, u64 mask)
+{
+  return _mm_and_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(mask)));
+}
+
+// a >= -0.0 ? c : b, slot by slot. NaNs pick b.
+inline Vec Select(Vec a, Vec c, Vec b)
+{
+  const Vec mask = _mm_cmpge_pd(a, _mm_setzero_pd());
+  return _mm_or_pd(_mm_and_pd(mask, c), _mm_andnot_pd(mask, b));
+}
+
+inline bool AnyNaN(Vec v)
+{
+  return _mm_movemask_pd(_mm_cmpunord_pd(v, v)) != 0;
+}
+
+inline bool AnyInf(Vec v)
+{
+  const Vec abs = BitAnd(v, ~Common::DOUBLE_SIGN);
+  return _mm_movemask_pd(_mm_cmpeq_pd(abs, _mm_set1_pd(std::numeric_limits<double>::infinity()))) !=
+         0;
+}
+
+// Round to single precision and back, like static_cast<float> on each slot
+inline Vec RoundToSingle(Vec v)
+{
+  return _mm_cvtps_pd(_mm_cvtpd_ps(v));
+}
+
+// The normal-number case of Force25Bit
+inline Vec Round25Bit(Vec v)
+{
+  const __m128i bits = _mm_castpd_si128(v);
+  const __m128i kept = _mm_and_si128(bits, _mm_set1_epi64x(0xFFFFFFFFF8000000));
+  const __m128i round = _mm_and_si128(bits, _mm_set1_epi64x(0x8000000));
+  return _mm_castsi128_pd(_mm_add_epi64(kept, round));
+}
+
+// Two quantized integers, already widened to 32 bits, scaled to floats and widened to doubles
+inline Vec Dequantize(s32 ps0, s32 ps1, float scale)
+{
+  const __m128 values = _mm_cvtepi32_ps(_mm_set_epi32(0, 0, ps1, ps0));
+  return _mm_cvtps_pd(_mm_mul_ps(values, _mm_set1_ps(scale)));
+}
+
+// Both slots rounded to single, scaled, clamped to [min, max] and truncated, as ScaleAndClamp
+// does. NaNs have no defined integer result, so those return nullopt.
+inline std::optional<std::pair<s32, s32>> Quantize(double ps0, double ps1, float scale, float min,
+                                                   float max)
+{
+  const __m128 values = _mm_cvtpd_ps(_mm_set_pd(ps1, ps0));
+  if ((_mm_movemask_ps(_mm_cmpunord_ps(values, values)) & 3) != 0) [[unlikely]]
+    return std::nullopt;
+
+  const __m128 scaled = _mm_mul_ps(values, _mm_set1_ps(scale));
+  const __m128 clamped = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(min)), _mm_set1_ps(max));
+  const __m128i ints = _mm_cvttps_epi32(clamped);
+  return std::pair{_mm_cvtsi128_si32(ints), _mm_cvtsi128_si32(_mm_srli_si128(ints, 4))};
+}
+
+#elif defined(PAIRED_SIMD_NEON)
+
+#define PAIRED_SIMD_TARGET_FMA
+inline bool HasFMA()
+{
+  return true;
+}
+
+using Vec = float64x2_t;
+
+inline Vec Load(const PowerPC::PairedSingle& ps)
+{
+  return vreinterpretq_f64_u64(vld1q_u64(&ps.ps0));
+}
+
+inline void Store(PowerPC::PairedSingle& ps, Vec v)
+{
+  vst1q_u64(&ps.ps0, vreinterpretq_u64_f64(v));
+}
+
+inline Vec Make(double ps0, double ps1)
+{
+  return vcombine_f64(vdup_n_f64(ps0), vdup_n_f64(ps1));
+}
+
+inline double Lane0(Vec v)
+{
+  return vgetq_lane_f64(v, 0);
+}
+
+inline double Lane1(Vec v)
+{
+  return vgetq_lane_f64(v, 1);
+}
+
+template <int A, int B>
+inline Vec Merge(Vec a, Vec b)
+{
+  return vcombine_f64(A == 0 ? vget_low_f64(a) : vget_high_f64(a),
+                      B == 0 ? vget_low_f64(b) : vget_high_f64(b));
+}
+
+inline Vec Add(Vec a, Vec b)
+{
+  return vaddq_f64(a, b);
+}
+
+inline Vec Sub(Vec a, Vec b)
+{
+  return vsubq_f64(a, b);
+}
+
+inline Vec Mul(Vec a, Vec b)
+{
+  return vmulq_f64(a, b);
+}
+
+inline Vec Div(Vec a, Vec b)
+{
+  return vdivq_f64(a, b);
+}
+
+inline Vec MAdd(Vec a, Vec c, Vec b)
+{
+  return vfmaq_f64(b, a, c);
+}
+
+inline Vec MSub(Vec a, Vec c, Vec b)
+{
+  return vfmaq_f64(vnegq_f64(b), a, c);
+}
+
+inline Vec BitXor(Vec a, u64 mask)
+{
+  return vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(mask)));
+}
+
+inline Vec BitOr(Vec a, u64 mask)
+{
+  return vreinterpretq_f64_u64(vorrq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(mask)));
+}
+
+inline Vec BitAnd(Vec a, u64 mask)
+{
+  return vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(mask)));
+}
+
+inline Vec Select(Vec a, Vec c, Vec b)
+{
+  return vbslq_f64(vcgeq_f64(a, vdupq_n_f64(0.0)), c, b);
+}
+
+inline bool AnyNaN(Vec v)
+{
+  const uint64x2_t ordered = vceqq_f64(v, v);
+  return (vgetq_lane_u64(ordered, 0) & vgetq_lane_u64(ordered, 1)) == 0;
+}
+
+inline bool AnyInf(Vec v)
+{
+  const uint64x2_t inf =
+      vceqq_f64(vabsq_f64(v), vdupq_n_f64(std::numeric_limits<double>::infinity()));
+  return (vgetq_lane_u64(inf, 0) | vgetq_lane_u64(inf, 1)) != 0;
+}
+
+inline Vec RoundToSingle(Vec v)
+{
+  return vcvt_f64_f32(vcvt_f32_f64(v));
+}
+
+inline Vec Round25Bit(Vec v)
+{
+  const uint64x2_t bits = vreinterpretq_u64_f64(v);
+  const uint64x2_t kept = vandq_u64(bits, vdupq_n_u64(0xFFFFFFFFF8000000));
+  const uint64x2_t round = vandq_u64(bits, vdupq_n_u64(0x8000000));
+  return vreinterpretq_f64_u64(vaddq_u64(kept, round));
+}
+
+inline Vec Dequantize(s32 ps0, s32 ps1, float scale)
+{
+  const int32x2_t values = vset_lane_s32(ps1, vdup_n_s32(ps0), 1);
+  return vcvt_f64_f32(vmul_n_f32(vcvt_f32_s32(values), scale));
+}
+
+inline std::optional<std::pair<s32, s32>> Quantize(double ps0, double ps1, float scale, float min,
+                                                   float max)
+{
+  const float32x2_t values = vcvt_f32_f64(Make(ps0, ps1));
+  const uint32x2_t ordered = vceq_f32(values, values);
+  if ((vget_lane_u32(ordered, 0) & vget_lane_u32(ordered, 1)) == 0) [[unlikely]]
+    return std::nullopt;
+
+  const float32x2_t scaled = vmul_n_f32(values, scale);
+  const float32x2_t clamped = vmin_f32(vmax_f32(scaled, vdup_n_f32(min)), vdup_n_f32(max));
+  const int32x2_t ints = vcvt_s32_f32(clamped);
+  return std::pair{vget_lane_s32(ints, 0), vget_lane_s32(ints, 1)};
+}
+
+#endif
+
+#if defined(PAIRED_SIMD_SSE2) || defined(PAIRED_SIMD_NEON)
+#define PAIRED_SIMD_AVAILABLE
+
+inline bool IsSubnormal(u64 bits)
+{
+  return (bits & Common::DOUBLE_EXP) == 0 && (bits & Common::DOUBLE_FRAC) != 0;
+}
+
+// Force25Bit on both slots. Subnormals normalize before rounding, which stays scalar.
+inline Vec Force25BitPair(const PowerPC::PairedSingle& c)
+{
+  if (IsSubnormal(c.ps0) || IsSubnormal(c.ps1)) [[unlikely]]
+    return Make(Force25Bit(c.PS0AsDouble()), Force25Bit(c.PS1AsDouble()));
+  return Round25Bit(Load(c));
+}
+
+// Force25Bit of one slot, in both slots (ps_muls0/1, ps_madds0/1)
+inline Vec Force25BitBroadcast(double c)
+{
+  const double rounded = Force25Bit(c);
+  return Make(rounded, rounded);
+}
+
+// ForceSingle on both slots, negated afterwards for the ps_nm* forms, written to `fd`. FPRF is
+// updated from slot 0 like the scalar instructions do.
+template <bool Negate = false>
+inline void StoreSingles(PowerPC::PowerPCState& ppc_state, u32 fd, Vec value)
+{
+  if (ppc_state.fpscr.NI) [[unlikely]]
+  {
+    // Non-IEEE mode flushes single subnormals, which only the scalar conversion knows about
+    float ps0 = ForceSingle(ppc_state.fpscr, Lane0(value));
+    float ps1 = ForceSingle(ppc_state.fpscr, Lane1(value));
+    if constexpr (Negate)
+    {
+      ps0 = -ps0;
+      ps1 = -ps1;
+    }
+    ppc_state.ps[fd].SetBoth(double(ps0), double(ps1));
+    ppc_state.UpdateFPRFSingle(ps0);
+    return;
+  }
+
+  // Negating only after rounding keeps the result right under directed rounding modes
+  Vec rounded = RoundToSingle(value);
+  if constexpr (Negate)
+    rounded = BitXor(rounded, Common::DOUBLE_SIGN);
+  Store(ppc_state.ps[fd], rounded);
+  ppc_state.UpdateFPRFSingle(float(Lane0(rounded)));
+}
+
+// a + b, a - b, a * c, a / b. On success the result is already stored in fd.
+enum class Arith
+{
+  Add,
+  Sub,
+  Mul,
+  Div,
+};
+
+template <Arith Op>
+inline bool TryArith(PowerPC::PowerPCState& ppc_state, u32 fd, Vec a, Vec b)
+{
+  Vec result;
+  if constexpr (Op == Arith::Add)
+    result = Add(a, b);
+  else if constexpr (Op == Arith::Sub)
+    result = Sub(a, b);
+  else if constexpr (Op == Arith::Mul)
+    result = Mul(a, b);
+  else
+    result = Div(a, b);
+
+  // NI_add and NI_sub clear FI/FR for infinite inputs, NI_div raises ZX for x/0
+  if (AnyNaN(result)) [[unlikely]]
+    return false;
+  if constexpr (Op == Arith::Add || Op == Arith::Sub)
+  {
+    if (AnyInf(a) || AnyInf(b)) [[unlikely]]
+      return false;
+  }
+  if constexpr (Op == Arith::Div)
+  {
+    if (AnyInf(result)) [[unlikely]]
+      return false;
+  }
+
+  StoreSingles(ppc_state, fd, result);
+  return true;
+}
+
+// a * c + b or a * c - b, negated for the ps_nm* forms. The scalar forms leave NaN results
+// alone, but those never get here.
+template <bool Subtract, bool Negate>
+PAIRED_SIMD_TARGET_FMA inline bool TryMAdd(PowerPC::PowerPCState& ppc_state, u32 fd, Vec a, Vec c,
+                                           Vec b)
+{
+  // std::fma without hardware support is exact but slow, so leave it to the scalar path
+  if (!HasFMA())
+    return false;
+
+  const Vec result = Subtract ? MSub(a, c, b) : MAdd(a, c, b);
+  if (AnyNaN(result) || AnyInf(a) || AnyInf(b) || AnyInf(c)) [[unlikely]]
+    return false;
+
+  StoreSingles<Negate>(ppc_state, fd, result);
+  return true;
+}
+
+#endif
+}  // namespace PairedSIMD
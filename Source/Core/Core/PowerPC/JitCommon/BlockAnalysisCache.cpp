@@ -0,0 +1,237 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/BlockAnalysisCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/HLE/HLE.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+// Ops are stored as raw bytes, with opinfo looked up again on load. LinearDiskCache rejects files
+// written by another build, so the layout only has to match within one.
+static_assert(std::is_trivially_copyable_v<PPCAnalyst::CodeOp>);
+// Keys and headers are written as-is, so they mustn't contain padding bytes
+static_assert(std::has_unique_object_representations_v<BlockAnalysisCache::Key>);
+
+// Copies `op` member by member into zeroed storage before writing it to `dst`, so the padding
+// CodeOp does have is written as zeroes instead of whatever the analyzer's buffer held, and the
+// same op always gives the same bytes on disk. opinfo is left null, as it's looked up again on load.
+static void WriteOpForDisk(const PPCAnalyst::CodeOp& op, u8* dst)
+{
+  PPCAnalyst::CodeOp out;
+  std::memset(static_cast<void*>(&out), 0, sizeof(out));
+  out.inst = op.inst;
+  out.address = op.address;
+  out.branchTo = op.branchTo;
+  out.regsIn = op.regsIn;
+  out.regsOut = op.regsOut;
+  out.fregsIn = op.fregsIn;
+  out.fregOut = op.fregOut;
+  out.crIn = op.crIn;
+  out.crOut = op.crOut;
+  out.branchUsesCtr = op.branchUsesCtr;
+  out.branchIsIdleLoop = op.branchIsIdleLoop;
+  out.wantsCR = op.wantsCR;
+  out.wantsFPRF = op.wantsFPRF;
+  out.wantsCA = op.wantsCA;
+  out.wantsCAInFlags = op.wantsCAInFlags;
+  out.outputCR = op.outputCR;
+  out.outputFPRF = op.outputFPRF;
+  out.outputCA = op.outputCA;
+  out.canEndBlock = op.canEndBlock;
+  out.canCauseException = op.canCauseException;
+  out.skipLRStack = op.skipLRStack;
+  out.skip = op.skip;
+  out.crInUse = op.crInUse;
+  out.crDiscardable = op.crDiscardable;
+  out.fprInUse = op.fprInUse;
+  out.gprInUse = op.gprInUse;
+  out.gprDiscardable = op.gprDiscardable;
+  out.fprDiscardable = op.fprDiscardable;
+  out.fprInXmm = op.fprInXmm;
+  out.fprIsSingle = op.fprIsSingle;
+  out.fprIsDuplicated = op.fprIsDuplicated;
+  out.fprIsStoreSafeBeforeInst = op.fprIsStoreSafeBeforeInst;
+  out.fprIsStoreSafeAfterInst = op.fprIsStoreSafeAfterInst;
+  std::memcpy(dst, &out, sizeof(out));
+}
+
+class BlockAnalysisCache::Reader final : public Common::LinearDiskCacheReader<Key, u8>
+{
+public:
+  explicit Reader(std::multimap<Key, Entry>& entries) : m_entries(entries) {}
+
+  void Read(const Key& key, const u8* value, u32 value_size) override
+  {
+    Entry entry;
+    if (value_size < sizeof(EntryHeader))
+      return;
+    std::memcpy(&entry.header, value, sizeof(EntryHeader));
+
+    const u32 num_instructions = entry.header.num_instructions;
+    if (num_instructions == 0 || num_instructions > key.block_size ||
+        value_size != sizeof(EntryHeader) + num_instructions * sizeof(PPCAnalyst::CodeOp))
+    {
+      return;
+    }
+
+    entry.ops.resize(num_instructions);
+    std::memcpy(entry.ops.data(), value + sizeof(EntryHeader),
+                num_instructions * sizeof(PPCAnalyst::CodeOp));
+    for (PPCAnalyst::CodeOp& op : entry.ops)
+      op.opinfo = PPCTables::GetOpInfo(op.inst, op.address);
+
+    m_entries.emplace(key, std::move(entry));
+  }
+
+private:
+  std::multimap<Key, Entry>& m_entries;
+};
+
+BlockAnalysisCache::BlockAnalysisCache(Core::System& system) : m_system(system)
+{
+}
+
+BlockAnalysisCache::~BlockAnalysisCache()
+{
+  Close();
+}
+
+void BlockAnalysisCache::Open(const std::string& game_id)
+{
+  // Also covers a game whose file couldn't be opened, so that isn't retried on every block
+  if (m_game_id == game_id)
+    return;
+
+  Close();
+  m_game_id = game_id;
+
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + "PPCAnalysis" DIR_SEP;
+  if (!File::IsDirectory(dir) && !File::CreateFullPath(dir))
+  {
+    WARN_LOG_FMT(DYNA_REC, "Couldn't create {}, not caching block analyses", dir);
+    return;
+  }
+
+  const std::string filename = dir + game_id + ".cache";
+  Reader reader(m_entries);
+  const u32 count = m_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} of {} cached block analyses from {}", m_entries.size(), count,
+               filename);
+
+  m_open = true;
+}
+
+void BlockAnalysisCache::Close()
+{
+  m_game_id.clear();
+  if (!m_open)
+    return;
+
+  m_disk_cache.Sync();
+  m_disk_cache.Close();
+  m_entries.clear();
+  m_open = false;
+}
+
+bool BlockAnalysisCache::HasHookOrBreakpoint(u32 address) const
+{
+  auto& power_pc = m_system.GetPowerPC();
+  return HLE::TryReplaceFunction(m_system.GetPPCSymbolDB(), address, power_pc.GetMode()) ||
+         power_pc.GetBreakPoints().IsAddressBreakPoint(address);
+}
+
+std::optional<u32> BlockAnalysisCache::Restore(const Key& key, PPCAnalyst::CodeBlock* block,
+                                               PPCAnalyst::CodeBuffer* buffer)
+{
+  auto& mmu = m_system.GetMMU();
+  const auto [begin, end] = m_entries.equal_range(key);
+  for (auto it = begin; it != end; ++it)
+  {
+    const Entry& entry = it->second;
+    if (entry.ops.size() > buffer->size())
+      continue;
+
+    // Analyze's liveness results depend on HLE hooks and breakpoints, and no stored entry covers
+    // either, so the entry only applies if the code is the same and still has neither.
+    block->m_physical_addresses.clear();
+    bool matches = true;
+    for (const PPCAnalyst::CodeOp& op : entry.ops)
+    {
+      const auto result = mmu.TryReadInstruction(op.address);
+      if (!result.valid || result.hex != op.inst.hex || HasHookOrBreakpoint(op.address))
+      {
+        matches = false;
+        break;
+      }
+      block->m_physical_addresses.insert(result.physical_address);
+    }
+    if (!matches)
+      continue;
+
+    std::copy(entry.ops.begin(), entry.ops.end(), buffer->begin());
+
+    const EntryHeader& header = entry.header;
+    block->m_address = key.address;
+    block->m_num_instructions = header.num_instructions;
+    block->m_stats->numCycles = header.num_cycles;
+    block->m_gpa->any = header.gpa_any != 0;
+    block->m_fpa->any = header.fpa_any != 0;
+    block->m_broken = false;
+    block->m_memory_exception = false;
+    block->m_gqr_used = BitSet8(header.gqr_used);
+    block->m_gqr_modified = BitSet8(header.gqr_modified);
+    block->m_gpr_inputs = BitSet32(header.gpr_inputs);
+    return header.next_pc;
+  }
+
+  block->m_physical_addresses.clear();
+  return std::nullopt;
+}
+
+void BlockAnalysisCache::Store(const Key& key, const PPCAnalyst::CodeBlock& block,
+                               const PPCAnalyst::CodeBuffer& buffer, u32 next_pc)
+{
+  // Broken blocks may have stopped early because the next instruction couldn't be read, which a
+  // later run can't tell apart from the same block with more code mapped after it.
+  if (block.m_memory_exception || block.m_broken || block.m_num_instructions == 0)
+    return;
+  if (m_entries.count(key) >= MAX_ENTRIES_PER_KEY)
+    return;
+
+  for (u32 i = 0; i < block.m_num_instructions; ++i)
+  {
+    if (HasHookOrBreakpoint(buffer[i].address))
+      return;
+  }
+
+  static_assert(std::has_unique_object_representations_v<EntryHeader>);
+  Entry entry{};
+  entry.header.next_pc = next_pc;
+  entry.header.num_instructions = block.m_num_instructions;
+  entry.header.num_cycles = block.m_stats->numCycles;
+  entry.header.gpr_inputs = block.m_gpr_inputs.m_val;
+  entry.header.gqr_used = block.m_gqr_used.m_val;
+  entry.header.gqr_modified = block.m_gqr_modified.m_val;
+  entry.header.gpa_any = block.m_gpa->any;
+  entry.header.fpa_any = block.m_fpa->any;
+  entry.ops.assign(buffer.begin(), buffer.begin() + block.m_num_instructions);
+
+  std::vector<u8> value(sizeof(EntryHeader) + entry.ops.size() * sizeof(PPCAnalyst::CodeOp));
+  std::memcpy(value.data(), &entry.header, sizeof(EntryHeader));
+  u8* ops_dst = value.data() + sizeof(EntryHeader);
+  for (size_t i = 0; i < entry.ops.size(); ++i)
+    WriteOpForDisk(entry.ops[i], ops_dst + i * sizeof(PPCAnalyst::CodeOp));
+  m_disk_cache.Append(key, value.data(), static_cast<u32>(value.size()));
+
+  m_entries.emplace(key, std::move(entry));
+}
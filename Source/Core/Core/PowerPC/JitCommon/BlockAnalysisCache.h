@@ -0,0 +1,91 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+namespace Core
+{
+class System;
+}
+
+// [emubench] Keeps the results of PPCAnalyzer::Analyze in a per-game LinearDiskCache file, so
+// blocks analyzed in an earlier run are restored instead of re-analyzed. An entry is only used if
+// every instruction it covers still reads the same from guest memory, which also takes care of
+// overlays and self-modifying code sharing an address.
+class BlockAnalysisCache final
+{
+public:
+  struct Key
+  {
+    u32 address;
+    u32 feature_flags;
+    u32 analyzer_configuration;
+    u32 block_size;
+
+    auto operator<=>(const Key&) const = default;
+  };
+
+  explicit BlockAnalysisCache(Core::System& system);
+  ~BlockAnalysisCache();
+
+  BlockAnalysisCache(const BlockAnalysisCache&) = delete;
+  BlockAnalysisCache& operator=(const BlockAnalysisCache&) = delete;
+
+  // Opens the cache file for the given game, loading every entry in it. Does nothing if that
+  // game was already opened, including when opening it failed; IsOpen() tells which.
+  void Open(const std::string& game_id);
+  void Close();
+  bool IsOpen() const { return m_open; }
+
+  // Fills in `block` and `buffer` as Analyze would have and returns the next PC, or returns
+  // std::nullopt if no entry for `key` matches the code currently in memory.
+  std::optional<u32> Restore(const Key& key, PPCAnalyst::CodeBlock* block,
+                             PPCAnalyst::CodeBuffer* buffer);
+  // Records a block Analyze just produced.
+  void Store(const Key& key, const PPCAnalyst::CodeBlock& block,
+             const PPCAnalyst::CodeBuffer& buffer, u32 next_pc);
+
+private:
+  struct EntryHeader
+  {
+    u32 next_pc;
+    u32 num_instructions;
+    u32 num_cycles;
+    u32 gpr_inputs;
+    u8 gqr_used;
+    u8 gqr_modified;
+    u8 gpa_any;
+    u8 fpa_any;
+  };
+
+  struct Entry
+  {
+    EntryHeader header;
+    std::vector<PPCAnalyst::CodeOp> ops;
+  };
+
+  class Reader;
+
+  // Different code at one address (overlays, code loaded at runtime) gets its own entry, up to
+  // this many per key.
+  static constexpr size_t MAX_ENTRIES_PER_KEY = 4;
+
+  bool HasHookOrBreakpoint(u32 address) const;
+
+  Core::System& m_system;
+  Common::LinearDiskCache<Key, u8> m_disk_cache;
+  std::multimap<Key, Entry> m_entries;
+  std::string m_game_id;
+  bool m_open = false;
+};
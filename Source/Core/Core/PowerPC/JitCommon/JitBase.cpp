@@ -57,7 +57,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 24> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -81,6 +81,7 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitB
     {&JitBase::m_accurate_nans, &Config::MAIN_ACCURATE_NANS},
     {&JitBase::m_fastmem_enabled, &Config::MAIN_FASTMEM},
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
+    {&JitBase::m_enable_block_analysis_cache, &Config::MAIN_JIT_BLOCK_ANALYSIS_CACHE},
 }};
 
 const u8* JitBase::Dispatch(JitBase& jit)
@@ -94,7 +95,7 @@ void JitTrampoline(JitBase& jit, u32 em_address)
 }
 
 JitBase::JitBase(Core::System& system)
-    : m_code_buffer(code_buffer_size), m_system(system), m_ppc_state(system.GetPPCState()),
+    : m_code_buffer(code_buffer_size), m_block_analysis_cache(system), m_system(system), m_ppc_state(system.GetPPCState()),
       m_mmu(system.GetMMU()), m_branch_watch(system.GetPowerPC().GetBranchWatch()),
       m_ppc_symbol_db(system.GetPPCSymbolDB())
 {
@@ -140,6 +141,32 @@ void JitBase::RefreshConfig()
   jo.memcheck = m_system.IsMMUMode() || m_system.IsPauseOnPanicMode() || any_watchpoints;
   jo.fp_exceptions = m_enable_float_exceptions;
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
+
+  if (!m_enable_block_analysis_cache)
+    m_block_analysis_cache.Close();
+}
+
+u32 JitBase::AnalyzeBlock(u32 em_address, std::size_t block_size)
+{
+  if (!m_enable_block_analysis_cache)
+    return analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+
+  // The game is only known once booting has started, after the JIT was initialized
+  m_block_analysis_cache.Open(SConfig::GetInstance().GetGameID());
+  if (!m_block_analysis_cache.IsOpen())
+    return analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+
+  const BlockAnalysisCache::Key key = {em_address, static_cast<u32>(m_ppc_state.feature_flags),
+                                       analyzer.GetConfiguration(), static_cast<u32>(block_size)};
+  if (const std::optional<u32> next_pc =
+          m_block_analysis_cache.Restore(key, &code_block, &m_code_buffer))
+  {
+    return *next_pc;
+  }
+
+  const u32 next_pc = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  m_block_analysis_cache.Store(key, code_block, m_code_buffer, next_pc);
+  return next_pc;
 }
 
 void JitBase::InitFastmemArena()
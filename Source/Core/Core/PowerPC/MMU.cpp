@@ -54,6 +54,7 @@ namespace PowerPC
 MMU::MMU(Core::System& system, Memory::MemoryManager& memory, PowerPC::PowerPCManager& power_pc)
     : m_system(system), m_memory(memory), m_power_pc(power_pc), m_ppc_state(power_pc.GetPPCState())
 {
+  ClearHostPageCache();
 }
 
 MMU::~MMU() = default;
@@ -153,6 +154,17 @@ T MMU::ReadFromHardware(u32 em_address)
   static_assert(flag == XCheckTLBFlag::NoException || flag == XCheckTLBFlag::Read ||
                 flag == XCheckTLBFlag::OpcodeNoException);
 
+  // [emubench]
+  if constexpr (flag == XCheckTLBFlag::Read && !never_translate)
+  {
+    if (const u8* host_page = LookupHostPageCache(m_host_read_pages, em_address, sizeof(T)))
+    {
+      T value;
+      std::memcpy(&value, host_page + (em_address & HW_PAGE_MASK), sizeof(T));
+      return bswap(value);
+    }
+  }
+
   const u32 em_address_start_page = em_address & ~HW_PAGE_MASK;
   const u32 em_address_end_page = (em_address + sizeof(T) - 1) & ~HW_PAGE_MASK;
   if (em_address_start_page != em_address_end_page)
@@ -170,6 +182,9 @@ T MMU::ReadFromHardware(u32 em_address)
   }
 
   bool wi = false;
+  // [emubench] Whether the page may go into m_host_read_pages if it turns out to be RAM
+  const u32 effective_address = em_address;
+  bool cacheable = flag == XCheckTLBFlag::Read && !never_translate && !m_ppc_state.m_enable_dcache;
 
   if (!never_translate &&
       (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value()))
@@ -183,6 +198,7 @@ T MMU::ReadFromHardware(u32 em_address)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    cacheable &= translated_addr.result == TranslateAddressResultEnum::BAT_TRANSLATED;
   }
 
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
@@ -217,6 +233,11 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetRAM()[em_address], sizeof(T));
+      if (cacheable)
+      {
+        FillHostPageCache(m_host_read_pages, effective_address,
+                          &m_memory.GetRAM()[em_address & ~HW_PAGE_MASK]);
+      }
     }
     else
     {
@@ -236,6 +257,11 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetEXRAM()[em_address], sizeof(T));
+      if (cacheable)
+      {
+        FillHostPageCache(m_host_read_pages, effective_address,
+                          &m_memory.GetEXRAM()[em_address & ~HW_PAGE_MASK]);
+      }
     }
     else
     {
@@ -254,6 +280,12 @@ T MMU::ReadFromHardware(u32 em_address)
     T value;
     std::memcpy(&value, &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()],
                 sizeof(T));
+    if (cacheable)
+    {
+      FillHostPageCache(m_host_read_pages, effective_address,
+                        &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask() &
+                                                ~HW_PAGE_MASK]);
+    }
     return bswap(value);
   }
 
@@ -273,6 +305,17 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   DEBUG_ASSERT(size <= 4);
 
+  // [emubench]
+  if constexpr (flag == XCheckTLBFlag::Write && !never_translate)
+  {
+    if (u8* host_page = LookupHostPageCache(m_host_write_pages, em_address, size))
+    {
+      const u32 swapped_data = Common::swap32(std::rotr(data, size * 8));
+      std::memcpy(host_page + (em_address & HW_PAGE_MASK), &swapped_data, size);
+      return;
+    }
+  }
+
   const u32 em_address_start_page = em_address & ~HW_PAGE_MASK;
   const u32 em_address_end_page = (em_address + size - 1) & ~HW_PAGE_MASK;
   if (em_address_start_page != em_address_end_page)
@@ -289,6 +332,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   }
 
   bool wi = false;
+  // [emubench] Whether the page may go into m_host_write_pages if it turns out to be RAM
+  const u32 effective_address = em_address;
+  bool cacheable =
+      flag == XCheckTLBFlag::Write && !never_translate && !m_ppc_state.m_enable_dcache;
 
   if (!never_translate && m_ppc_state.msr.DR)
   {
@@ -301,6 +348,8 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    cacheable &= translated_addr.result == TranslateAddressResultEnum::BAT_TRANSLATED &&
+                 !translated_addr.wi;
   }
 
   // Check for a gather pipe write (which are not implemented through the MMIO system).
@@ -417,6 +466,11 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
       std::memcpy(&m_memory.GetRAM()[em_address], &swapped_data, size);
 
+    if (cacheable)
+    {
+      FillHostPageCache(m_host_write_pages, effective_address,
+                        &m_memory.GetRAM()[em_address & ~HW_PAGE_MASK]);
+    }
     return;
   }
 
@@ -434,6 +488,11 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
       std::memcpy(&m_memory.GetEXRAM()[em_address], &swapped_data, size);
 
+    if (cacheable)
+    {
+      FillHostPageCache(m_host_write_pages, effective_address,
+                        &m_memory.GetEXRAM()[em_address & ~HW_PAGE_MASK]);
+    }
     return;
   }
 
@@ -444,6 +503,12 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   {
     std::memcpy(&m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()], &swapped_data,
                 size);
+    if (cacheable)
+    {
+      FillHostPageCache(m_host_write_pages, effective_address,
+                        &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask() &
+                                                ~HW_PAGE_MASK]);
+    }
     return;
   }
 
@@ -1628,6 +1693,7 @@ void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 void MMU::DBATUpdated()
 {
   m_dbat_table = {};
+  ClearHostPageCache();
   UpdateBATs(m_dbat_table, SPR_DBAT0U);
   bool extended_bats = m_system.IsWii() && HID4(m_ppc_state).SBE;
   if (extended_bats)
@@ -1647,6 +1713,32 @@ void MMU::DBATUpdated()
   m_system.GetJitInterface().ClearSafe();
 }
 
+void MMU::ClearHostPageCache()
+{
+  m_host_read_pages.fill({HOST_PAGE_CACHE_INVALID_TAG, nullptr});
+  m_host_write_pages.fill({HOST_PAGE_CACHE_INVALID_TAG, nullptr});
+}
+
+u32 MMU::GetHostPageCacheTag(u32 address) const
+{
+  return (address & ~static_cast<u32>(HW_PAGE_MASK)) | m_ppc_state.msr.DR.Value();
+}
+
+u8* MMU::LookupHostPageCache(const HostPageCache& cache, u32 address, u32 size) const
+{
+  const HostPageCacheEntry& entry =
+      cache[(address >> HW_PAGE_INDEX_SHIFT) % HOST_PAGE_CACHE_SIZE];
+  if (entry.tag != GetHostPageCacheTag(address) || (address & HW_PAGE_MASK) + size > HW_PAGE_SIZE)
+    return nullptr;
+  return entry.host_page;
+}
+
+void MMU::FillHostPageCache(HostPageCache& cache, u32 effective_address, u8* host_page)
+{
+  cache[(effective_address >> HW_PAGE_INDEX_SHIFT) % HOST_PAGE_CACHE_SIZE] = {
+      GetHostPageCacheTag(effective_address), host_page};
+}
+
 void MMU::IBATUpdated()
 {
   m_ibat_table = {};
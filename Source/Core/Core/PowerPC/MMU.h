@@ -241,6 +241,8 @@ public:
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
+  // [emubench] Forgets every cached effective page -> host pointer mapping
+  void ClearHostPageCache();
 
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
@@ -305,6 +307,25 @@ private:
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
 
+  // [emubench] A small direct-mapped cache from effective page to host pointer, filled when a load
+  // or store resolves to MEM1, MEM2 or fake VMEM. A hit skips translation and the EFB/MMIO/locked
+  // L1 checks. Only untranslated and BAT-translated pages are cached, and nothing is cached while
+  // the data cache is emulated, so a hit never skips a side effect. Reads and writes have separate
+  // caches because write-through/cache-inhibited pages are only cacheable for reads.
+  struct HostPageCacheEntry
+  {
+    // Effective page address | MSR.DR, or HOST_PAGE_CACHE_INVALID_TAG
+    u32 tag;
+    u8* host_page;
+  };
+  static constexpr u32 HOST_PAGE_CACHE_SIZE = 256;
+  static constexpr u32 HOST_PAGE_CACHE_INVALID_TAG = 0xFFFFFFFF;
+  using HostPageCache = std::array<HostPageCacheEntry, HOST_PAGE_CACHE_SIZE>;
+
+  u32 GetHostPageCacheTag(u32 address) const;
+  u8* LookupHostPageCache(const HostPageCache& cache, u32 address, u32 size) const;
+  void FillHostPageCache(HostPageCache& cache, u32 effective_address, u8* host_page);
+
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
   template <XCheckTLBFlag flag, bool never_translate = false>
@@ -326,6 +347,9 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  HostPageCache m_host_read_pages;
+  HostPageCache m_host_write_pages;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
@@ -737,55 +737,84 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
+// [emubench] Instructions a busy wait loop may contain besides integer ops, loads and branches.
+// They either only move values between registers, which the read-before-write rules in
+// IsBusyWaitLoop cover, or have no architectural effect that a second iteration could observe.
+static bool IsBusyWaitSafeInstruction(const CodeOp& op)
+{
+  switch (op.opinfo->type)
+  {
+  case OpType::Integer:
+  case OpType::Load:
+  case OpType::LoadFP:
+  case OpType::LoadPS:
+  case OpType::CR:
+    return true;
+  case OpType::System:
+    // mcrf, mfcr, mtcrf, sync. Notably not mftb: a loop polling the time base would be skipped
+    // past its deadline.
+    return (op.inst.OPCD == 19 && op.inst.SUBOP10 == 0) ||
+           (op.inst.OPCD == 31 &&
+            (op.inst.SUBOP10 == 19 || op.inst.SUBOP10 == 144 || op.inst.SUBOP10 == 598));
+  case OpType::InstructionCache:
+    // isync
+    return op.inst.OPCD == 19 && op.inst.SUBOP10 == 150;
+  default:
+    return false;
+  }
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //   * It loops to itself, and any other branches in it don't use CTR.
+  //   * It does not write to memory or SPRs.
+  //   * It only reads from registers (GPRs, FPRs, CR fields and CA) it wrote to
+  //     earlier in the loop, or it does not write to these registers.
+  //
+  // A loop like that computes the same state every iteration until an interrupt or a
+  // scheduled event (a DSP mailbox, VI, or another thread's store done in an exception
+  // handler) changes the memory or MMIO register it polls, so the time until the next
+  // event can be skipped.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
+  // With OPTION_BRANCH_FOLLOW, bl/cmp/bne loops calling a pure leaf function (the
+  // most common way to poll DSP registers) are inlined into the block and pass the
+  // same checks. Without it, such loops aren't detected.
+  BitSet32 write_disallowed_regs, written_regs;
+  BitSet32 write_disallowed_fregs, written_fregs;
+  BitSet8 write_disallowed_crs, written_crs;
+  bool write_disallowed_ca = false, written_ca = false;
   for (size_t i = 0; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+    const CodeOp& op = code[i];
+    if (op.opinfo->type == OpType::Branch)
     {
-      if (code[i].branchUsesCtr)
+      if (op.branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    else if (!IsBusyWaitSafeInstruction(op))
     {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
       return false;
     }
-    else
+
+    write_disallowed_regs |= op.regsIn & ~written_regs;
+    write_disallowed_fregs |= op.fregsIn & ~written_fregs;
+    write_disallowed_crs |= op.crIn & ~written_crs;
+    write_disallowed_ca |= op.wantsCA && !written_ca;
+
+    const BitSet32 fregs_out = op.GetFregsOut();
+    if ((op.regsOut & write_disallowed_regs) || (fregs_out & write_disallowed_fregs) ||
+        (op.crOut & write_disallowed_crs) || (op.outputCA && write_disallowed_ca))
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      return false;
     }
+    written_regs |= op.regsOut;
+    written_fregs |= fregs_out;
+    written_crs |= op.crOut;
+    written_ca |= op.outputCA;
+
+    if (op.opinfo->type == OpType::Branch && op.branchTo == block->m_address && i == instructions)
+      return true;
   }
   return false;
 }
@@ -181,6 +181,12 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  // [emubench] Everything besides the code in memory that Analyze's results depend on
+  u32 GetConfiguration() const
+  {
+    return m_options | (m_is_debugging_enabled << 16) | (m_enable_branch_following << 17) |
+           (m_enable_float_exceptions << 18) | (m_enable_div_by_zero_exceptions << 19);
+  }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
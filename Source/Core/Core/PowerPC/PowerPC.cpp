@@ -254,6 +254,10 @@ void PowerPCManager::RefreshConfig()
     INFO_LOG_FMT(POWERPC, "Flushing data cache");
     m_ppc_state.dCache.FlushAll(m_system.GetMemory());
   }
+
+  // [emubench] RAM pages are only cached by the MMU while the data cache isn't emulated
+  if (old_enable_dcache != m_ppc_state.m_enable_dcache)
+    m_system.GetMMU().ClearHostPageCache();
 }
 
 void PowerPCManager::Init(CPUCore cpu_core)
@@ -9,6 +9,7 @@
 #include <cstring>
 #include <signal.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef _WIN32
@@ -17,6 +18,7 @@
 #include <Windows.h>
 #endif
 
+#include "Common/FileUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
@@ -37,6 +39,7 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 // [emubench]
+#include "IPC/BlockProfiler.h"
 #include "IPC/HTTPServer.h"
 
 static std::unique_ptr<Platform> s_platform;
@@ -200,6 +203,47 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+// [emubench] Profiles <frames> frames, starting after the first one the IPC server counts, and
+// writes the hottest JIT blocks to a file. In turn-based mode those are frames a client steps.
+static std::thread StartBlockProfile(optparse::Values& options)
+{
+  const u32 frames = static_cast<unsigned int>(options.get("profile_blocks"));
+  const size_t top = options.is_set("profile_blocks_top") ?
+                         static_cast<unsigned long>(options.get("profile_blocks_top")) :
+                         IPC::BlockProfiler::DEFAULT_TOP;
+  const std::string path = static_cast<const char*>(options.get("profile_blocks_output"));
+  const std::optional<IPC::HotBlockFormat> format =
+      IPC::ParseHotBlockFormat(static_cast<const char*>(options.get("profile_blocks_format")));
+
+  if (frames == 0 || !format)
+  {
+    fprintf(stderr, "--profile-blocks needs a positive frame count and a json or folded format\n");
+    return {};
+  }
+
+  return std::thread([frames, top, path, format = *format] {
+    IPC::HTTPServer& server = IPC::HTTPServer::GetInstance();
+    // The CPU core is only known once the emulation thread is running frames
+    if (!server.WaitXFramesWhileRunning(1))
+      return;
+    if (!IPC::BlockProfiler::IsSupported())
+    {
+      fprintf(stderr, "Block profiling needs a JIT or the cached interpreter CPU core\n");
+      return;
+    }
+
+    const std::optional<IPC::HotBlockReport> report = IPC::BlockProfiler::GetInstance().Capture(
+        frames, top, [&server](u32 n) { return server.WaitXFramesWhileRunning(n); });
+    if (!report)
+      return;
+
+    if (!File::WriteStringToFile(path, IPC::BlockProfiler::Format(*report, format)))
+      fprintf(stderr, "Failed to write the block profile to %s\n", path.c_str());
+    else
+      fprintf(stdout, "Wrote the block profile to %s\n", path.c_str());
+  });
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -231,6 +275,25 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  // [emubench]
+  parser->add_option("--profile-blocks")
+      .type("int")
+      .metavar("<frames>")
+      .help("Profile JIT blocks over <frames> emulated frames and write the hottest ones "
+            "to --profile-blocks-output");
+  parser->add_option("--profile-blocks-top")
+      .type("int")
+      .metavar("<count>")
+      .help("Number of blocks to list in the block profile (default 50)");
+  parser->add_option("--profile-blocks-output")
+      .action("store")
+      .metavar("<file>")
+      .set_default("block_profile.json")
+      .help("File to write the block profile to");
+  parser->add_option("--profile-blocks-format")
+      .choices({"json", "folded"})
+      .set_default("json")
+      .help("Block profile format, JSON or flamegraph folded stacks [%choices]");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -340,6 +403,11 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  // [emubench]
+  std::thread block_profile_thread;
+  if (options.is_set("profile_blocks"))
+    block_profile_thread = StartBlockProfile(options);
+
 #ifdef USE_DISCORD_PRESENCE
   Discord::UpdateDiscordPresence();
 #endif
@@ -348,6 +416,9 @@ int main(int argc, char* argv[])
   Core::Stop(Core::System::GetInstance());
 
   Core::Shutdown(Core::System::GetInstance());
+  // [emubench] An unfinished capture notices the shutdown within a second
+  if (block_profile_thread.joinable())
+    block_profile_thread.join();
   s_platform.reset();
 
   return 0;
@@ -0,0 +1,152 @@
+#include "IPC/BlockProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "Common/ScopeGuard.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/System.h"
+
+namespace IPC
+{
+
+std::optional<HotBlockFormat> ParseHotBlockFormat(std::string_view name)
+{
+  if (name == "json")
+    return HotBlockFormat::JSON;
+  if (name == "folded")
+    return HotBlockFormat::Folded;
+  return std::nullopt;
+}
+
+BlockProfiler& BlockProfiler::GetInstance()
+{
+  static BlockProfiler instance;
+  return instance;
+}
+
+bool BlockProfiler::IsSupported()
+{
+  return Core::System::GetInstance().GetJitInterface().GetCore() != nullptr;
+}
+
+std::optional<HotBlockReport> BlockProfiler::Capture(u32 frames, size_t top,
+                                                     const std::function<bool(u32)>& wait_frames)
+{
+  std::lock_guard<std::mutex> lk(m_capture_lock);
+  Core::System& system = Core::System::GetInstance();
+  JitInterface& jit_interface = system.GetJitInterface();
+
+  // Changing this clears the block cache on the CPU thread, and the recompiled blocks carry
+  // profile data. Blocks compiled before that are empty and skipped below.
+  const bool was_enabled = Config::Get(Config::MAIN_DEBUG_JIT_ENABLE_PROFILING);
+  if (!was_enabled)
+    Config::SetCurrent(Config::MAIN_DEBUG_JIT_ENABLE_PROFILING, true);
+  Common::ScopeGuard restore_guard([was_enabled] {
+    if (!was_enabled)
+      Config::SetCurrent(Config::MAIN_DEBUG_JIT_ENABLE_PROFILING, false);
+  });
+
+  {
+    Core::CPUThreadGuard guard(system);
+    jit_interface.WipeBlockProfilingData(guard);
+  }
+
+  if (!wait_frames(frames))
+    return std::nullopt;
+
+  HotBlockReport report;
+  report.frames = frames;
+
+  Core::CPUThreadGuard guard(system);
+  jit_interface.RunOnBlocks(guard, [&report](const JitBlock& block) {
+    const JitBlock::ProfileData* const data = block.profile_data.get();
+    if (data == nullptr || data->run_count == 0)
+      return;
+
+    HotBlock hot;
+    hot.address = block.effectiveAddress;
+    hot.run_count = data->run_count;
+    hot.cycles = data->cycles_spent;
+    hot.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(data->time_spent).count();
+    hot.instructions = block.originalSize;
+
+    report.total_run_count += hot.run_count;
+    report.total_cycles += hot.cycles;
+    report.total_time_ns += hot.time_ns;
+    report.blocks.push_back(std::move(hot));
+  });
+  report.profiled_blocks = report.blocks.size();
+
+  const auto hottest = report.blocks.begin() + std::min(top, report.blocks.size());
+  std::partial_sort(report.blocks.begin(), hottest, report.blocks.end(),
+                    [](const HotBlock& a, const HotBlock& b) { return a.time_ns > b.time_ns; });
+  report.blocks.erase(hottest, report.blocks.end());
+
+  // Only the listed blocks need a symbol
+  PPCSymbolDB& symbol_db = system.GetPPCSymbolDB();
+  for (HotBlock& hot : report.blocks)
+  {
+    if (const Common::Symbol* symbol = symbol_db.GetSymbolFromAddr(hot.address))
+      hot.symbol = symbol->name;
+  }
+
+  return report;
+}
+
+nlohmann::json BlockProfiler::ToJson(const HotBlockReport& report)
+{
+  nlohmann::json blocks = nlohmann::json::array();
+  for (const HotBlock& hot : report.blocks)
+  {
+    const double time_percent =
+        report.total_time_ns == 0 ? 0.0 : 100.0 * hot.time_ns / report.total_time_ns;
+    blocks.push_back({
+        {"address", fmt::format("{:08x}", hot.address)},
+        {"symbol", hot.symbol},
+        {"runCount", hot.run_count},
+        {"cycles", hot.cycles},
+        {"timeNs", hot.time_ns},
+        {"instructions", hot.instructions},
+        {"timePercent", time_percent},
+    });
+  }
+
+  return {{"frames", report.frames},
+          {"profiledBlocks", report.profiled_blocks},
+          {"totalRunCount", report.total_run_count},
+          {"totalCycles", report.total_cycles},
+          {"totalTimeNs", report.total_time_ns},
+          {"blocks", blocks}};
+}
+
+std::string BlockProfiler::ToFolded(const HotBlockReport& report)
+{
+  // Blocks have no guest call stack, so each stack is the containing function and the block
+  std::string folded;
+  for (const HotBlock& hot : report.blocks)
+  {
+    std::string symbol = hot.symbol.empty() ? "[unknown]" : hot.symbol;
+    // ';' separates frames and ' ' the count, so neither may appear in a frame name
+    std::ranges::replace(symbol, ';', ':');
+    std::ranges::replace(symbol, ' ', '_');
+    fmt::format_to(std::back_inserter(folded), "{};{:08x} {}\n", symbol, hot.address, hot.time_ns);
+  }
+  return folded;
+}
+
+std::string BlockProfiler::Format(const HotBlockReport& report, HotBlockFormat format)
+{
+  if (format == HotBlockFormat::Folded)
+    return ToFolded(report);
+  return ToJson(report).dump();
+}
+
+} // namespace IPC
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace IPC
+{
+
+// [emubench] One JIT block's share of a profiling window
+struct HotBlock
+{
+  u32 address = 0;
+  // Function containing the block, empty if no symbol covers it
+  std::string symbol;
+  u64 run_count = 0;
+  // Emulated cycles, as counted by the block's downcount
+  u64 cycles = 0;
+  // Host time spent running the block
+  u64 time_ns = 0;
+  u32 instructions = 0;
+};
+
+struct HotBlockReport
+{
+  u32 frames = 0;
+  // Totals over every block that ran in the window, not just the listed ones
+  size_t profiled_blocks = 0;
+  u64 total_run_count = 0;
+  u64 total_cycles = 0;
+  u64 total_time_ns = 0;
+  // Most host time first
+  std::vector<HotBlock> blocks;
+};
+
+enum class HotBlockFormat : u8
+{
+  JSON,
+  // Flamegraph folded stacks: "symbol;block nanoseconds" per line
+  Folded,
+};
+
+std::optional<HotBlockFormat> ParseHotBlockFormat(std::string_view name);
+
+// Reads JitBlock::ProfileData over a window of frames. Works with the JITs and the cached
+// interpreter; the plain interpreter has no blocks to profile.
+class BlockProfiler final
+{
+public:
+  // Singleton pattern
+  static BlockProfiler& GetInstance();
+
+  // Delete copy constructor and assignment operator
+  BlockProfiler(const BlockProfiler&) = delete;
+  BlockProfiler& operator=(const BlockProfiler&) = delete;
+
+  static constexpr u32 DEFAULT_FRAMES = 60;
+  static constexpr size_t DEFAULT_TOP = 50;
+
+  static bool IsSupported();
+
+  // Turns on block profiling for the window if it's off, clears the counters, lets `wait_frames`
+  // run `frames` frames and returns the `top` hottest blocks. `wait_frames` returns false if
+  // emulation stopped first, and then so does this. Captures run one at a time.
+  std::optional<HotBlockReport> Capture(u32 frames, size_t top,
+                                        const std::function<bool(u32)>& wait_frames);
+
+  static nlohmann::json ToJson(const HotBlockReport& report);
+  static std::string ToFolded(const HotBlockReport& report);
+  static std::string Format(const HotBlockReport& report, HotBlockFormat format);
+
+private:
+  BlockProfiler() = default;
+
+  std::mutex m_capture_lock;
+};
+
+} // namespace IPC
@@ -6,6 +6,8 @@
 #include "Core/System.h"
 #include "Common/Logging/Log.h"
 
+#include <algorithm>
+
 #include <nlohmann/json.hpp>
 
 namespace IPC {
@@ -125,6 +127,82 @@ std::vector<IPCControllerInput> ParseIPCControllerInputSequence(const nlohmann::
   return inputs;
 }
 
+// [emubench] Parse a batch: the same "inputs" array as a sequence, plus a per-step "captureFrame"
+// flag. "captureFrames" ("all", "last" or "none", default "last") sets it for steps that omit it.
+std::vector<IPCBatchStep> ParseIPCBatchSteps(const nlohmann::json& j) {
+  std::vector<IPCBatchStep> steps;
+  std::vector<IPCControllerInput> inputs = ParseIPCControllerInputSequence(j);
+  if (inputs.empty()) {
+    return steps;
+  }
+
+  std::string capture_mode = "last";
+  if (j.contains("captureFrames") && j["captureFrames"].is_string()) {
+    capture_mode = j["captureFrames"].get<std::string>();
+  }
+
+  const auto& inputs_array = j["inputs"];
+  steps.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    IPCBatchStep step;
+    step.input = inputs[i];
+    step.capture_frame = capture_mode == "all" || (capture_mode == "last" && i == inputs.size() - 1);
+
+    const auto& input_json = inputs_array[i];
+    if (input_json.contains("captureFrame") && input_json["captureFrame"].is_boolean()) {
+      step.capture_frame = input_json["captureFrame"].get<bool>();
+    }
+
+    steps.push_back(step);
+  }
+
+  return steps;
+}
+
+std::optional<ObservationParams> ParseIPCObservation(const nlohmann::json& j) {
+  if (!j.is_object()) {
+    return std::nullopt;
+  }
+
+  ObservationParams params;
+  for (const char* key : {"width", "height", "stack"}) {
+    if (j.contains(key) && !(j[key].is_number_unsigned() && j[key].get<uint32_t>() <= 4096)) {
+      NOTICE_LOG_FMT(CORE, "IPC: Invalid observation {}", key);
+      return std::nullopt;
+    }
+  }
+  params.width = j.value("width", 0u);
+  params.height = j.value("height", 0u);
+  params.stack = std::max(j.value("stack", 1u), 1u);
+
+  if (j.contains("grayscale")) {
+    if (!j["grayscale"].is_boolean()) {
+      return std::nullopt;
+    }
+    params.grayscale = j["grayscale"].get<bool>();
+  }
+
+  if (j.contains("crop")) {
+    const auto& crop = j["crop"];
+    if (!crop.is_array() || crop.size() != 4) {
+      NOTICE_LOG_FMT(CORE, "IPC: Observation crop must be [x, y, width, height]");
+      return std::nullopt;
+    }
+    for (const auto& value : crop) {
+      if (!value.is_number() || value.get<float>() < 0.0f || value.get<float>() > 1.0f) {
+        NOTICE_LOG_FMT(CORE, "IPC: Observation crop values must be in [0, 1]");
+        return std::nullopt;
+      }
+    }
+    const float x = crop[0].get<float>();
+    const float y = crop[1].get<float>();
+    params.crop = MathUtil::Rectangle<float>(x, y, std::min(x + crop[2].get<float>(), 1.0f),
+                                             std::min(y + crop[3].get<float>(), 1.0f));
+  }
+
+  return params;
+}
+
 GCPadStatus ConvertToGCPadStatus(const IPCControllerInput& input) {
   GCPadStatus status;
   memset(&status, 0, sizeof(status));
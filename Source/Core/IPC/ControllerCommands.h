@@ -1,9 +1,11 @@
 #pragma once
 
 #include "InputCommon/GCPadStatus.h"
+#include "VideoCommon/FrameDumper.h"
 
 #include <nlohmann/json.hpp>
 
+#include <optional>
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -44,8 +46,19 @@ struct IPCControllerInput {
   uint32_t frames = 0;
 };
 
+// [emubench] One step of a batched rollout: an input held for `input.frames` frames, optionally
+// followed by a frame capture
+struct IPCBatchStep {
+  IPCControllerInput input;
+  bool capture_frame = false;
+};
+
 IPCControllerInput ParseIPCControllerInput(const nlohmann::json& j);
 std::vector<IPCControllerInput> ParseIPCControllerInputSequence(const nlohmann::json& j);
+std::vector<IPCBatchStep> ParseIPCBatchSteps(const nlohmann::json& j);
+// [emubench] Parses an "observation" object: width, height, crop [x, y, w, h] (normalized),
+// grayscale, stack. Returns std::nullopt if any field is malformed.
+std::optional<ObservationParams> ParseIPCObservation(const nlohmann::json& j);
 GCPadStatus ConvertToGCPadStatus(const IPCControllerInput& input);
 
 } // Namespace IPC
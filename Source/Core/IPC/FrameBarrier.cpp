@@ -0,0 +1,60 @@
+#include "IPC/FrameBarrier.h"
+
+#include <algorithm>
+
+namespace IPC
+{
+
+FrameBarrier::FrameBarrier()
+{
+  // Waiting is only ever done by a handful of HTTP threads; keep registration allocation-free
+  m_wait_targets.reserve(16);
+}
+
+u64 FrameBarrier::Advance()
+{
+  const u64 frame = ++m_frame;
+
+  // Pairs with the store to m_next_wake in WaitForFrame: either we see the waiter's target here,
+  // or the waiter sees the new frame before going to sleep.
+  if (frame >= m_next_wake.load())
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+    }
+    m_condvar.notify_all();
+  }
+
+  return frame;
+}
+
+bool FrameBarrier::WaitForFrame(u64 frame, std::optional<std::chrono::milliseconds> timeout)
+{
+  if (m_frame.load() >= frame)
+    return true;
+
+  std::unique_lock<std::mutex> lk(m_mutex);
+  m_wait_targets.push_back(frame);
+  UpdateNextWake();
+
+  const auto reached = [&] { return m_frame.load() >= frame; };
+  bool success = true;
+  if (timeout)
+    success = m_condvar.wait_for(lk, *timeout, reached);
+  else
+    m_condvar.wait(lk, reached);
+
+  m_wait_targets.erase(std::ranges::find(m_wait_targets, frame));
+  UpdateNextWake();
+
+  return success;
+}
+
+// Called with m_mutex held
+void FrameBarrier::UpdateNextWake()
+{
+  const auto lowest = std::ranges::min_element(m_wait_targets);
+  m_next_wake.store(lowest != m_wait_targets.end() ? *lowest : NO_WAITERS);
+}
+
+} // namespace IPC
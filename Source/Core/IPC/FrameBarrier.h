@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace IPC
+{
+
+// [emubench] Lets any number of threads wait for an absolute frame number.
+// The frame callback only touches the mutex when a waiter's target frame has been reached, so
+// advancing a frame nobody is waiting for is a single atomic increment.
+class FrameBarrier final
+{
+public:
+  FrameBarrier();
+
+  FrameBarrier(const FrameBarrier&) = delete;
+  FrameBarrier& operator=(const FrameBarrier&) = delete;
+
+  // Called once per frame by the frame callback. Returns the new frame number.
+  u64 Advance();
+  u64 GetFrame() const { return m_frame.load(); }
+
+  // Blocks until GetFrame() >= frame. Returns false if the timeout expired first.
+  bool WaitForFrame(u64 frame,
+                    std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+private:
+  static constexpr u64 NO_WAITERS = ~u64{0};
+
+  void UpdateNextWake();
+
+  std::atomic<u64> m_frame = 0;
+  // Lowest frame any waiter is blocked on, or NO_WAITERS
+  std::atomic<u64> m_next_wake = NO_WAITERS;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condvar;
+  std::vector<u64> m_wait_targets;
+};
+
+} // namespace IPC
@@ -170,25 +170,13 @@ public:
   }
 
   bool postScreenshot(const std::string& filePath, const std::string& testId) {
-    NOTICE_LOG_FMT(CORE, "IPC: Uploading screenshot to GCS");
-    CURL* curl = curl_easy_init();
-
-    if (!curl) {
-      NOTICE_LOG_FMT(CORE, "IPC: Unable to init curl");
-      return false;
-    }
-
     // Extract filename from filepath
     std::string screenshotName = filePath.substr(filePath.find_last_of("/") + 1);
 
-    std::string url = "https://storage.googleapis.com/upload/storage/v1/b/emubench-sessions/o?uploadType=media&name=" + testId + "/ScreenShots/" + screenshotName;
-    NOTICE_LOG_FMT(CORE, "IPC: GCS URL: {}", url);
-
     // Open the file
     FILE* file = fopen(filePath.c_str(), "rb");
     if (!file) {
       NOTICE_LOG_FMT(CORE, "IPC: Unable to open file: {}", filePath);
-      curl_easy_cleanup(curl);
       return false;
     }
 
@@ -204,10 +192,26 @@ public:
 
     if (bytes_read != static_cast<size_t>(file_size)) {
       NOTICE_LOG_FMT(CORE, "IPC: Failed to read complete file");
-      curl_easy_cleanup(curl);
       return false;
     }
 
+    return postScreenshotData(screenshotName, file_buffer.data(), file_buffer.size(), "image/png", testId);
+  }
+
+  // [emubench] Uploads an already encoded screenshot, e.g. one captured in memory
+  bool postScreenshotData(const std::string& screenshotName, const char* data, size_t size,
+                          const std::string& contentType, const std::string& testId) {
+    NOTICE_LOG_FMT(CORE, "IPC: Uploading screenshot to GCS");
+    CURL* curl = curl_easy_init();
+
+    if (!curl) {
+      NOTICE_LOG_FMT(CORE, "IPC: Unable to init curl");
+      return false;
+    }
+
+    std::string url = "https://storage.googleapis.com/upload/storage/v1/b/emubench-sessions/o?uploadType=media&name=" + testId + "/ScreenShots/" + screenshotName;
+    NOTICE_LOG_FMT(CORE, "IPC: GCS URL: {}", url);
+
     // Set up response capture
     std::string response_body;
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
@@ -215,13 +219,14 @@ public:
 
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, file_buffer.data());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, file_size);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(size));
 
     struct curl_slist* headers = nullptr;
     std::string authHeader = "Authorization: Bearer " + accessToken;
     headers = curl_slist_append(headers, authHeader.c_str());
-    headers = curl_slist_append(headers, "Content-Type: image/png");
+    std::string contentTypeHeader = "Content-Type: " + contentType;
+    headers = curl_slist_append(headers, contentTypeHeader.c_str());
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
     CURLcode res = curl_easy_perform(curl);
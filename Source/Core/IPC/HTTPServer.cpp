@@ -66,35 +66,53 @@ void HTTPServer::ServerThread(int port) {
 		res.set_content("{\"screenshotName\":\"" + screenshot_name + "\"}", "application/json");
 	});
 	
-	m_server.Post("/api/controller/:port", [this](const httplib::Request& req, httplib::Response& res) {
-		// First check if the port is a valid number
-		const std::string& port_str = req.path_params.at("port");
-		bool valid_number = true;
-		int port = 0;
+	// [emubench] Serves a screenshot by name. In-memory screenshots are encoded on request
+	// ("encoding": png, qoi or rgba, defaulting to the configured one); file screenshots are PNG.
+	m_server.Get("/api/screenshot/:name", [this](const httplib::Request& req, httplib::Response& res) {
+		const std::string name = req.path_params.at("name");
+
+		if (std::shared_ptr<const CapturedFrame> frame = IPC::ScreenshotStore::GetInstance().Get(name)) {
+			ScreenshotEncoding encoding = IPC::ScreenshotStore::GetInstance().GetEncoding();
+			if (req.has_param("encoding")) {
+				std::optional<ScreenshotEncoding> parsed = ParseScreenshotEncoding(req.get_param_value("encoding"));
+				if (!parsed) {
+					res.status = 400;
+					res.set_content("{\"error\":\"encoding must be one of 'png', 'qoi', 'rgba'\"}", "application/json");
+					return;
+				}
+				encoding = *parsed;
+			}
 
-		// Check if the string contains only digits
-		for (char c : port_str) {
-			if (!std::isdigit(c)) {
-				valid_number = false;
-				break;
+			std::optional<std::vector<u8>> encoded = IPC::ScreenshotStore::Encode(*frame, encoding);
+			if (!encoded) {
+				res.status = 500;
+				res.set_content("{\"error\":\"Failed to encode screenshot\"}", "application/json");
+				return;
 			}
+			res.set_header("X-Width", std::to_string(frame->width));
+			res.set_header("X-Height", std::to_string(frame->height));
+			res.set_header("X-Channels", std::to_string(frame->channels));
+			res.set_header("X-Layers", std::to_string(frame->layers));
+			res.set_content(reinterpret_cast<const char*>(encoded->data()), encoded->size(), GetScreenshotContentType(encoding));
+			return;
 		}
 
-		// If it's a valid number format, convert it safely
-		if (valid_number && !port_str.empty()) {
-			port = std::atoi(port_str.c_str());
+		File::IOFile file(File::GetUserPath(D_SCREENSHOTS_IDX) + name + ".png", "rb");
+		std::string png(file.IsOpen() ? file.GetSize() : 0, '\0');
+		if (!file.IsOpen() || !file.ReadBytes(png.data(), png.size())) {
+			res.status = 404;
+			res.set_content("{\"error\":\"Screenshot not found\"}", "application/json");
+			return;
+		}
+		res.set_content(png, "image/png");
+	});
 
-			// Check if port is in valid range (0-3)
-			if (port < 0 || port > 3) {
-				res.status = 400;
-				res.set_content("{\"error\":\"Invalid controller port. Must be 0-3\"}", "application/json");
-				return;
-			}
-		} else {
-			res.status = 400;
-			res.set_content("{\"error\":\"Invalid port parameter\"}", "application/json");
+	m_server.Post("/api/controller/:port", [this](const httplib::Request& req, httplib::Response& res) {
+		std::optional<int> parsed_port = ParseControllerPort(req, res);
+		if (!parsed_port) {
 			return;
 		}
+		const int port = *parsed_port;
 
 		std::optional<nlohmann::json_abi_v3_12_0::json> json_data = ParseJson(req.body);
 		if (!json_data) {
@@ -103,6 +121,18 @@ void HTTPServer::ServerThread(int port) {
       return;
 		}
 
+		// [emubench] Optional observation shaping for the step's frame (in-memory screenshots only)
+		std::optional<ObservationParams> observation;
+		if (json_data->contains("observation")) {
+			observation = ParseIPCObservation((*json_data)["observation"]);
+			if (!observation || IPC::ScreenshotStore::GetInstance().GetMode() != ScreenshotMode::Memory) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid 'observation', or screenshotMode is not 'memory'\"}", "application/json");
+				return;
+			}
+		}
+		const uint32_t capture_lead = GetCaptureLead(observation);
+
 		// If turn-based, play the game
 		if (!m_real_time) {
 			Core::System& system = Core::System::GetInstance();
@@ -110,7 +140,6 @@ void HTTPServer::ServerThread(int port) {
 		}
 
 		constexpr uint32_t MINIMUM_FRAMES = 2;
-		constexpr uint32_t SCREENSHOT_PIPELINE_FRAMES = 2;
 
 		// [emubench] Detect if this is a sequence (array) format or single input format
 		bool is_sequence = json_data->contains("inputs") && (*json_data)["inputs"].is_array();
@@ -127,9 +156,9 @@ void HTTPServer::ServerThread(int port) {
 
 			// Validate all inputs have valid frame counts
 			for (size_t i = 0; i < inputs.size(); ++i) {
-				if (inputs[i].frames < MINIMUM_FRAMES) {
+				if (inputs[i].frames < MINIMUM_FRAMES || (i == inputs.size() - 1 && inputs[i].frames < capture_lead)) {
 					res.status = 400;
-					res.set_content("{\"error\":\"Each input must have frames >= 2. Input " + std::to_string(i) + " has frames=" + std::to_string(inputs[i].frames) + "\"}", "application/json");
+					res.set_content("{\"error\":\"Each input must have frames >= 2 (the last >= " + std::to_string(std::max(MINIMUM_FRAMES, capture_lead)) + "). Input " + std::to_string(i) + " has frames=" + std::to_string(inputs[i].frames) + "\"}", "application/json");
 					return;
 				}
 			}
@@ -149,8 +178,8 @@ void HTTPServer::ServerThread(int port) {
 					// Not the last input: wait for full duration then queue next
 					HTTPServer::WaitXFrames(frame_count);
 				} else {
-					// Last input: wait until SCREENSHOT_PIPELINE_FRAMES before end
-					uint32_t frames_before_screenshot = frame_count - SCREENSHOT_PIPELINE_FRAMES;
+					// Last input: wait until the capture has to start before the end
+					uint32_t frames_before_screenshot = frame_count - capture_lead;
 					HTTPServer::WaitXFrames(frames_before_screenshot);
 				}
 			}
@@ -166,16 +195,16 @@ void HTTPServer::ServerThread(int port) {
 			}
 
 			uint32_t frame_count = (*json_data)["frames"].get<uint32_t>();
-			if (frame_count < MINIMUM_FRAMES) {
+			if (frame_count < MINIMUM_FRAMES || frame_count < capture_lead) {
 				res.status = 400;
-				res.set_content("{\"error\":\"frames must be >= 2 for screenshot pipeline\"}", "application/json");
+				res.set_content("{\"error\":\"frames must be >= " + std::to_string(std::max(MINIMUM_FRAMES, capture_lead)) + " for screenshot pipeline\"}", "application/json");
 				return;
 			}
 
 			Pad::QueueTimedInput(port, status, frame_count);
 			NOTICE_LOG_FMT(CORE, "IPC: Queued timed input for pad {} for {} frames", port, frame_count);
 
-			uint32_t frames_before_screenshot = frame_count - SCREENSHOT_PIPELINE_FRAMES;
+			uint32_t frames_before_screenshot = frame_count - capture_lead;
 			HTTPServer::WaitXFrames(frames_before_screenshot);
 		}
 
@@ -184,16 +213,13 @@ void HTTPServer::ServerThread(int port) {
 		static thread_local Common::Event screenshot_completion_event;
 		screenshot_completion_event.Reset();
 		if (g_frame_dumper) {
-			g_frame_dumper->SaveScreenshotWithCallback(
-				File::GetUserPath(D_SCREENSHOTS_IDX) + screenshot_name + ".png",
-				&screenshot_completion_event
-			);
+			HTTPServer::QueueScreenshot(screenshot_name, &screenshot_completion_event, observation);
 			NOTICE_LOG_FMT(CORE, "IPC: Screenshot {} queued at frame {}, waiting {} more frames",
-				screenshot_name, m_frame_count, SCREENSHOT_PIPELINE_FRAMES);
+				screenshot_name, m_frame_barrier.GetFrame(), capture_lead);
 		}
 
 		// Wait remaining frames for screenshot capture + flush
-		HTTPServer::WaitXFrames(SCREENSHOT_PIPELINE_FRAMES);
+		HTTPServer::WaitXFrames(capture_lead);
 
 		// If turn-based, pause the game
 		if (!m_real_time) {
@@ -208,30 +234,154 @@ void HTTPServer::ServerThread(int port) {
 		}
 		HTTPServer::UploadScreenshotToGcp(screenshot_name);
 
+		const bool watches_fresh = HTTPServer::RefreshEpisodeWatches();
 		std::map<std::string, std::string> endStateMemWatches = HTTPServer::ReadMemWatches(m_end_state_watch_names);
 		std::map<std::string, std::string> contextMemWatches = HTTPServer::ReadMemWatches(m_context_watch_names);
 
 		nlohmann::json response = {{"endStateMemWatchValues", endStateMemWatches}, {"contextMemWatchValues", contextMemWatches}, {"screenshot", screenshot_name}};
+		// [emubench] The input has already run, so report the step with the last values read
+		if (!watches_fresh) {
+			response["memWatchValuesStale"] = true;
+		}
+		if (json_data->value("inlineScreenshot", false)) {
+			if (std::optional<nlohmann::json> inline_screenshot = HTTPServer::InlineScreenshot(screenshot_name)) {
+				response["screenshotData"] = *inline_screenshot;
+			}
+		}
+
+		res.set_content(response.dump(), "application/json");
+	});
+
+	// [emubench] Batched rollout: runs every step from the frame callback, recording memwatch values
+	// (and optionally a frame) at the end of each step, and only wakes this thread once at the end.
+	m_server.Post("/api/controller/:port/batch", [this](const httplib::Request& req, httplib::Response& res) {
+		std::optional<int> parsed_port = ParseControllerPort(req, res);
+		if (!parsed_port) {
+			return;
+		}
+
+		std::optional<nlohmann::json_abi_v3_12_0::json> json_data = ParseJson(req.body);
+		if (!json_data) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Invalid JSON payload\"}", "application/json");
+			return;
+		}
+
+		std::vector<IPCBatchStep> steps = ParseIPCBatchSteps(*json_data);
+		if (steps.empty()) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Empty or invalid 'inputs' array\"}", "application/json");
+			return;
+		}
+
+		std::optional<ObservationParams> observation;
+		if (json_data->contains("observation")) {
+			observation = ParseIPCObservation((*json_data)["observation"]);
+			if (!observation || IPC::ScreenshotStore::GetInstance().GetMode() != ScreenshotMode::Memory) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid 'observation', or screenshotMode is not 'memory'\"}", "application/json");
+				return;
+			}
+		}
+		const uint32_t capture_lead = GetCaptureLead(observation);
+
+		for (size_t i = 0; i < steps.size(); ++i) {
+			if (steps[i].input.frames < BATCH_MINIMUM_FRAMES || (steps[i].capture_frame && steps[i].input.frames < capture_lead)) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Each input must have frames >= 2 (>= " + std::to_string(capture_lead) + " when captured). Input " + std::to_string(i) + " has frames=" + std::to_string(steps[i].input.frames) + "\"}", "application/json");
+				return;
+			}
+		}
+
+		// [emubench] Optional watch names whose predicate firing ends the batch after the current step
+		std::vector<std::string> stop_on;
+		if (json_data->contains("stopOn") && (*json_data)["stopOn"].is_array()) {
+			for (const auto& name : (*json_data)["stopOn"]) {
+				if (name.is_string()) {
+					stop_on.push_back(name.get<std::string>());
+				}
+			}
+		}
 
+		std::optional<BatchResult> result = RunBatch(*parsed_port, std::move(steps), std::move(stop_on), observation);
+		if (!result) {
+			res.status = 409;
+			res.set_content("{\"error\":\"Another batch is still running\"}", "application/json");
+			return;
+		}
+		const bool inline_screenshots = json_data->value("inlineScreenshot", false);
+
+		nlohmann::json steps_json = nlohmann::json::array();
+		for (const BatchObservation& observation : result->observations) {
+			nlohmann::json step_json = {
+				{"frame", observation.frame},
+				{"endStateMemWatchValues", observation.end_state_watches},
+				{"contextMemWatchValues", observation.context_watches}
+			};
+			if (observation.watches_stale) {
+				step_json["memWatchValuesStale"] = true;
+			}
+			if (observation.screenshot) {
+				HTTPServer::UploadScreenshotToGcp(*observation.screenshot);
+				step_json["screenshot"] = *observation.screenshot;
+				if (inline_screenshots) {
+					if (std::optional<nlohmann::json> inline_screenshot = HTTPServer::InlineScreenshot(*observation.screenshot)) {
+						step_json["screenshotData"] = *inline_screenshot;
+					}
+				}
+			}
+			steps_json.push_back(step_json);
+		}
+
+		nlohmann::json response = {{"steps", steps_json}};
+		if (result->stopped_by) {
+			response["stoppedBy"] = WatchEventToJson(*result->stopped_by);
+		}
 		res.set_content(response.dump(), "application/json");
 	});
 
 	m_server.Get("/api/memwatch/values", [this](const httplib::Request& req, httplib::Response& res) {
+		// [emubench] Optionally wait for an absolute frame number first ("frame", "timeoutMs"). The
+		// wait is bounded like the event endpoints', since a paused game may never reach the frame.
+		if (req.has_param("frame")) {
+			const u64 frame = std::strtoull(req.get_param_value("frame").c_str(), nullptr, 10);
+			long long timeout_ms = req.has_param("timeoutMs") ? std::strtoll(req.get_param_value("timeoutMs").c_str(), nullptr, 10) : MAX_EVENT_WAIT_MS;
+			timeout_ms = std::clamp<long long>(timeout_ms, 0, MAX_EVENT_WAIT_MS);
+
+			if (!m_frame_barrier.WaitForFrame(frame, std::chrono::milliseconds(timeout_ms))) {
+				res.status = 408;
+				nlohmann::json error = {{"error", "Timed out waiting for frame"}, {"frame", m_frame_barrier.GetFrame()}};
+				res.set_content(error.dump(), "application/json");
+				return;
+			}
+		}
+
 		if (req.has_param("names")) {
-			std::string names_param = req.get_param_value("names");
-        
-			// Parse the names (assuming comma-separated values)
-			std::vector<std::string> names;
-			std::stringstream ss(names_param);
-			std::string name;
-			
-			while (getline(ss, name, ',')) {
-				names.push_back(name);
+			std::vector<std::string> names = ParseWatchNames(req.get_param_value("names"));
+
+			// [emubench] Stale values would look just like fresh ones, so fail instead
+			if (!IPC::MemWatcher::GetInstance().RefreshValues(names)) {
+				res.status = 503;
+				res.set_content("{\"error\":\"Timed out reading memwatches\"}", "application/json");
+				return;
 			}
-			
+
+			// [emubench] "format": "hex" (default), "typed" (JSON numbers) or "msgpack" (typed, MessagePack)
+			const std::string format = req.has_param("format") ? req.get_param_value("format") : "hex";
+			if (format == "typed" || format == "msgpack") {
+				nlohmann::json response = {{"values", HTTPServer::ReadMemWatchesTyped(names)}, {"frame", m_frame_barrier.GetFrame()}};
+				if (format == "msgpack") {
+					std::vector<u8> packed = nlohmann::json::to_msgpack(response);
+					res.set_content(reinterpret_cast<const char*>(packed.data()), packed.size(), "application/msgpack");
+				} else {
+					res.set_content(response.dump(), "application/json");
+				}
+				return;
+			}
+
 			std::map<std::string, std::string> results = HTTPServer::ReadMemWatches(names);
 
-			nlohmann::json response = {{"values", results}};
+			nlohmann::json response = {{"values", results}, {"frame", m_frame_barrier.GetFrame()}};
 			res.set_content(response.dump(), "application/json");
 		} else {
 			res.status = 400;
@@ -240,6 +390,79 @@ void HTTPServer::ServerThread(int port) {
 		}
 	});
 
+	// [emubench] Binary memwatch values, see ReadMemWatchesBinary for the layout
+	m_server.Get("/api/memwatch/raw", [this](const httplib::Request& req, httplib::Response& res) {
+		if (!req.has_param("names")) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Must pass 'names' query param\"}", "application/json");
+			return;
+		}
+
+		const std::vector<std::string> names = ParseWatchNames(req.get_param_value("names"));
+		if (!IPC::MemWatcher::GetInstance().RefreshValues(names)) {
+			res.status = 503;
+			res.set_content("{\"error\":\"Timed out reading memwatches\"}", "application/json");
+			return;
+		}
+
+		std::string body = HTTPServer::ReadMemWatchesBinary(names);
+		res.set_header("X-Frame", std::to_string(m_frame_barrier.GetFrame()));
+		res.set_content(body.data(), body.size(), "application/octet-stream");
+	});
+
+	// [emubench] Predicate events with sequence >= "since", long-polling up to "timeoutMs" for one
+	m_server.Get("/api/memwatch/events", [this](const httplib::Request& req, httplib::Response& res) {
+		const u64 since = req.has_param("since") ? std::strtoull(req.get_param_value("since").c_str(), nullptr, 10) : 0;
+		const std::vector<std::string> names = req.has_param("names") ? ParseWatchNames(req.get_param_value("names")) : std::vector<std::string>{};
+		long long timeout_ms = req.has_param("timeoutMs") ? std::strtoll(req.get_param_value("timeoutMs").c_str(), nullptr, 10) : 0;
+		timeout_ms = std::clamp<long long>(timeout_ms, 0, MAX_EVENT_WAIT_MS);
+
+		std::vector<WatchEvent> events = IPC::MemWatcher::GetInstance().GetEvents(since, names, std::chrono::milliseconds(timeout_ms));
+
+		nlohmann::json events_json = nlohmann::json::array();
+		for (const WatchEvent& event : events) {
+			events_json.push_back(WatchEventToJson(event));
+		}
+		const u64 next = events.empty() ? since : events.back().sequence + 1;
+		nlohmann::json response = {{"events", events_json}, {"next", next}, {"frame", m_frame_barrier.GetFrame()}};
+		res.set_content(response.dump(), "application/json");
+	});
+
+	// [emubench] Same events as a server-sent-events stream. Starts at "since" (or Last-Event-ID + 1
+	// on reconnect), otherwise with the next event to fire.
+	m_server.Get("/api/memwatch/events/stream", [this](const httplib::Request& req, httplib::Response& res) {
+		u64 since = IPC::MemWatcher::GetInstance().GetNextEventSequence();
+		if (req.has_param("since")) {
+			since = std::strtoull(req.get_param_value("since").c_str(), nullptr, 10);
+		} else if (req.has_header("Last-Event-ID")) {
+			since = std::strtoull(req.get_header_value("Last-Event-ID").c_str(), nullptr, 10) + 1;
+		}
+		std::vector<std::string> names = req.has_param("names") ? ParseWatchNames(req.get_param_value("names")) : std::vector<std::string>{};
+
+		auto next = std::make_shared<u64>(since);
+		res.set_header("Cache-Control", "no-cache");
+		res.set_chunked_content_provider("text/event-stream", [this, next, names](size_t, httplib::DataSink& sink) {
+			if (!m_running) {
+				sink.done();
+				return true;
+			}
+
+			std::vector<WatchEvent> events = IPC::MemWatcher::GetInstance().GetEvents(*next, names, std::chrono::milliseconds(MAX_EVENT_WAIT_MS));
+			if (events.empty()) {
+				// Keeps proxies from closing an idle stream and notices clients that went away
+				static constexpr std::string_view keepalive = ": keepalive\n\n";
+				return sink.write(keepalive.data(), keepalive.size());
+			}
+
+			std::string chunk;
+			for (const WatchEvent& event : events) {
+				chunk += "id: " + std::to_string(event.sequence) + "\nevent: memwatch\ndata: " + WatchEventToJson(event).dump() + "\n\n";
+				*next = event.sequence + 1;
+			}
+			return sink.write(chunk.data(), chunk.size());
+		});
+	});
+
 	m_server.Post("/api/emulation/state", [this](const httplib::Request& req, httplib::Response& res) {
 		std::optional<nlohmann::json_abi_v3_12_0::json> json_data = ParseJson(req.body);
 		if (!json_data) {
@@ -249,7 +472,54 @@ void HTTPServer::ServerThread(int port) {
 		}
 
 		if (json_data->contains("action") && (*json_data)["action"].is_string()) {
-			if ((*json_data)["action"].get<std::string>() == "save") {
+			const std::string action = (*json_data)["action"].get<std::string>();
+
+			// [emubench] In-memory snapshots: {"action": "save" | "load" | "delete", "snapshot": "<id>"}
+			// Saves also accept "delta": true and/or "base": "<id>" for page-shared delta snapshots
+			if (json_data->contains("snapshot")) {
+				if (!(*json_data)["snapshot"].is_string()) {
+					res.status = 400;
+					res.set_content("{\"error\":\"Invalid JSON value: snapshot must be a string id\"}", "application/json");
+					return;
+				}
+
+				const std::string snapshot_id = (*json_data)["snapshot"].get<std::string>();
+				bool success = false;
+				if (action == "save") {
+					// Delta snapshots store guest memory as pages shared with their "base" snapshot
+					const bool has_base = json_data->contains("base") && (*json_data)["base"].is_string();
+					const bool delta = has_base || (json_data->contains("delta") && (*json_data)["delta"].is_boolean() &&
+						(*json_data)["delta"].get<bool>());
+					if (delta) {
+						const std::string base_id = has_base ? (*json_data)["base"].get<std::string>() : "";
+						success = IPC::SaveState::GetInstance().SaveToDeltaSnapshot(snapshot_id, base_id);
+					} else {
+						success = IPC::SaveState::GetInstance().SaveToSnapshot(snapshot_id);
+					}
+				} else if (action == "load") {
+					success = IPC::SaveState::GetInstance().LoadFromSnapshot(snapshot_id);
+				} else if (action == "delete") {
+					success = IPC::SaveState::GetInstance().DeleteSnapshot(snapshot_id);
+				} else {
+					res.status = 400;
+					res.set_content("{\"error\":\"Invalid snapshot action. Must be 'save', 'load', or 'delete'\"}", "application/json");
+					return;
+				}
+
+				if (!success) {
+					res.status = action == "save" ? 500 : 404;
+					nlohmann::json error = {{"error", "Snapshot " + action + " failed for '" + snapshot_id + "'"}};
+					res.set_content(error.dump(), "application/json");
+					return;
+				}
+
+				nlohmann::json response = {{"status", "ok"}, {"snapshots", IPC::SaveState::GetInstance().GetSnapshotIds()},
+					{"poolBytes", IPC::SaveState::GetInstance().GetSnapshotPoolSize()}};
+				res.set_content(response.dump(), "application/json");
+				return;
+			}
+
+			if (action == "save") {
 				if (!json_data->contains("to")) {
 					res.status = 400;
 					res.set_content("{\"error\":\"Invalid JSON value: to is required\"}", "application/json");
@@ -265,7 +535,7 @@ void HTTPServer::ServerThread(int port) {
 					res.set_content("{\"error\":\"Invalid JSON value: to must be filepath or slot number\"}", "application/json");
 					return;
 				}
-			} else if ((*json_data)["action"].get<std::string>() == "load") {
+			} else if (action == "load") {
 				if ((*json_data)["to"].is_string()) {
 					IPC::SaveState::GetInstance().LoadFromFile((*json_data)["to"].get<std::string>());
 				} else if ((*json_data)["to"].is_number_unsigned()) {
@@ -275,10 +545,10 @@ void HTTPServer::ServerThread(int port) {
 					res.set_content("{\"error\":\"Invalid JSON value: to must be filepath or slot number\"}", "application/json");
 					return;
 				}
-			} else if((*json_data)["action"].get<std::string>() == "pause") {
+			} else if (action == "pause") {
 				Core::System& system = Core::System::GetInstance();
 				Core::SetState(system, Core::State::Paused);
-			} else if((*json_data)["action"].get<std::string>() == "play") {
+			} else if (action == "play") {
 				Core::System& system = Core::System::GetInstance();
 				Core::SetState(system, Core::State::Running);
 			} else {
@@ -295,6 +565,87 @@ void HTTPServer::ServerThread(int port) {
 		res.set_content("{\"status\":\"ok\"}", "application/json");
 	});
 
+	// [emubench] Snapshot transfer between emulator instances running the same game. Lets a pool of
+	// already-booted workers adopt any branch state without booting or touching disk.
+	m_server.Get("/api/emulation/snapshot/:id", [this](const httplib::Request& req, httplib::Response& res) {
+		const std::string& snapshot_id = req.path_params.at("id");
+		std::optional<std::vector<u8>> bytes = IPC::SaveState::GetInstance().ExportSnapshot(snapshot_id);
+		if (!bytes) {
+			res.status = 404;
+			res.set_content("{\"error\":\"Snapshot not found\"}", "application/json");
+			return;
+		}
+
+		res.set_content(reinterpret_cast<const char*>(bytes->data()), bytes->size(), "application/octet-stream");
+	});
+
+	m_server.Post("/api/emulation/snapshot/:id", [this](const httplib::Request& req, httplib::Response& res) {
+		const std::string& snapshot_id = req.path_params.at("id");
+		if (!IPC::SaveState::GetInstance().ImportSnapshot(snapshot_id, req.body)) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Invalid or oversized snapshot payload\"}", "application/json");
+			return;
+		}
+
+		res.set_content("{\"status\":\"ok\"}", "application/json");
+	});
+
+	// [emubench] Emulator counters. idleSkips/idleSkippedCycles count busy wait loops fast-forwarded
+	// to the next scheduled event since boot; divide the cycles by cpuClock for emulated seconds.
+	m_server.Get("/api/emulation/stats", [this](const httplib::Request& req, httplib::Response& res) {
+		Core::System& system = Core::System::GetInstance();
+		const CoreTiming::CoreTimingManager::IdleSkipStats idle = system.GetCoreTiming().GetIdleSkipStats();
+		nlohmann::json response = {{"idleSkips", idle.skips}, {"idleSkippedCycles", idle.skipped_cycles},
+			{"cpuClock", system.GetSystemTimers().GetTicksPerSecond()},
+			{"renderSkippedFrames", g_render_skip.GetSkippedFrames()}};
+		res.set_content(response.dump(), "application/json");
+	});
+
+	// [emubench] Hottest JIT blocks over the next "frames" frames ("top", "format": json/folded)
+	m_server.Get("/api/profile/blocks", [this](const httplib::Request& req, httplib::Response& res) {
+		if (!BlockProfiler::IsSupported()) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Block profiling needs a JIT or the cached interpreter CPU core\"}", "application/json");
+			return;
+		}
+
+		u32 frames = BlockProfiler::DEFAULT_FRAMES;
+		if (req.has_param("frames")) {
+			frames = static_cast<u32>(std::strtoull(req.get_param_value("frames").c_str(), nullptr, 10));
+		}
+		size_t top = BlockProfiler::DEFAULT_TOP;
+		if (req.has_param("top")) {
+			top = std::strtoull(req.get_param_value("top").c_str(), nullptr, 10);
+		}
+		std::optional<HotBlockFormat> format = HotBlockFormat::JSON;
+		if (req.has_param("format")) {
+			format = ParseHotBlockFormat(req.get_param_value("format"));
+		}
+		if (frames == 0 || !format) {
+			res.status = 400;
+			res.set_content("{\"error\":\"frames must be positive and format one of json, folded\"}", "application/json");
+			return;
+		}
+
+		Core::System& system = Core::System::GetInstance();
+		if (!m_real_time) {
+			Core::SetState(system, Core::State::Running);
+		}
+		const std::optional<HotBlockReport> report = BlockProfiler::GetInstance().Capture(
+			frames, top, [this](u32 n) { return WaitXFramesWhileRunning(n); });
+		if (!m_real_time) {
+			Core::SetState(system, Core::State::Paused);
+		}
+
+		if (!report) {
+			res.status = 503;
+			res.set_content("{\"error\":\"Emulation stopped during the capture\"}", "application/json");
+			return;
+		}
+		res.set_content(BlockProfiler::Format(*report, *format),
+			*format == HotBlockFormat::Folded ? "text/plain" : "application/json");
+	});
+
 	m_server.Post("/api/emulation/config", [this](const httplib::Request& req, httplib::Response& res) {
 		// Parse JSON body
 		std::optional<nlohmann::json_abi_v3_12_0::json> json_data = ParseJson(req.body);
@@ -304,12 +655,90 @@ void HTTPServer::ServerThread(int port) {
       return;
 		}
 
-		if (json_data->contains("speed") && (*json_data)["speed"].is_number()) {
+		bool applied = false;
+
+		if (json_data->contains("speed")) {
+			if (!(*json_data)["speed"].is_number()) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: speed must be a number\"}", "application/json");
+				return;
+			}
 			Config::SetCurrent(Config::MAIN_EMULATION_SPEED, (*json_data)["speed"].get<float>());
-		} else {
+			applied = true;
+		}
+
+		// [emubench] In-memory snapshot pool settings
+		if (json_data->contains("snapshotCompression")) {
+			if (!(*json_data)["snapshotCompression"].is_boolean()) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: snapshotCompression must be a boolean\"}", "application/json");
+				return;
+			}
+			IPC::SaveState::GetInstance().SetSnapshotCompression((*json_data)["snapshotCompression"].get<bool>());
+			applied = true;
+		}
+
+		if (json_data->contains("snapshotBudgetMB")) {
+			if (!(*json_data)["snapshotBudgetMB"].is_number_unsigned()) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: snapshotBudgetMB must be an unsigned number\"}", "application/json");
+				return;
+			}
+			IPC::SaveState::GetInstance().SetSnapshotBudget((*json_data)["snapshotBudgetMB"].get<u64>() * 1024 * 1024);
+			applied = true;
+		}
+
+		// [emubench] Screenshot delivery: "file" PNGs on disk (default) or "memory", encoded on demand
+		if (json_data->contains("screenshotMode")) {
+			std::optional<ScreenshotMode> mode = (*json_data)["screenshotMode"].is_string() ?
+				ParseScreenshotMode((*json_data)["screenshotMode"].get<std::string>()) : std::nullopt;
+			if (!mode) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: screenshotMode must be 'file' or 'memory'\"}", "application/json");
+				return;
+			}
+			IPC::ScreenshotStore::GetInstance().SetMode(*mode);
+			applied = true;
+		}
+
+		if (json_data->contains("screenshotEncoding")) {
+			std::optional<ScreenshotEncoding> encoding = (*json_data)["screenshotEncoding"].is_string() ?
+				ParseScreenshotEncoding((*json_data)["screenshotEncoding"].get<std::string>()) : std::nullopt;
+			if (!encoding) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: screenshotEncoding must be 'png', 'qoi' or 'rgba'\"}", "application/json");
+				return;
+			}
+			IPC::ScreenshotStore::GetInstance().SetEncoding(*encoding);
+			applied = true;
+		}
+
+		// [emubench] Fast-forward through frames without a pending screenshot
+		if (json_data->contains("skipUnobservedFrames")) {
+			if (!(*json_data)["skipUnobservedFrames"].is_boolean()) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: skipUnobservedFrames must be a boolean\"}", "application/json");
+				return;
+			}
+			Config::SetCurrent(Config::GFX_HACK_SKIP_UNOBSERVED_FRAMES, (*json_data)["skipUnobservedFrames"].get<bool>());
+			applied = true;
+		}
+
+		// [emubench] Event scheduler selection, picked up by CoreTiming on the CPU thread
+		if (json_data->contains("timingWheel")) {
+			if (!(*json_data)["timingWheel"].is_boolean()) {
+				res.status = 400;
+				res.set_content("{\"error\":\"Invalid JSON value: timingWheel must be a boolean\"}", "application/json");
+				return;
+			}
+			Config::SetCurrent(Config::MAIN_TIMING_WHEEL, (*json_data)["timingWheel"].get<bool>());
+			applied = true;
+		}
+
+		if (!applied) {
 			res.status = 400;
-      res.set_content("{\"error\":\"Invalid JSON value: speed must be a number\"}", "application/json");
-      return;
+			res.set_content("{\"error\":\"Must pass at least one of 'speed', 'snapshotCompression', 'snapshotBudgetMB', 'screenshotMode', 'screenshotEncoding', 'timingWheel', 'skipUnobservedFrames'\"}", "application/json");
+			return;
 		}
 
 		res.set_content("{\"status\":\"ok\"}", "application/json");
@@ -378,6 +807,48 @@ void HTTPServer::ServerThread(int port) {
 	m_running = false;
 }
 
+std::optional<int> HTTPServer::ParseControllerPort(const httplib::Request& req, httplib::Response& res) {
+	// First check if the port is a valid number
+	const std::string& port_str = req.path_params.at("port");
+
+	// Check if the string contains only digits
+	for (char c : port_str) {
+		if (!std::isdigit(c)) {
+			res.status = 400;
+			res.set_content("{\"error\":\"Invalid port parameter\"}", "application/json");
+			return std::nullopt;
+		}
+	}
+
+	if (port_str.empty()) {
+		res.status = 400;
+		res.set_content("{\"error\":\"Invalid port parameter\"}", "application/json");
+		return std::nullopt;
+	}
+
+	// Check if port is in valid range (0-3)
+	int port = std::atoi(port_str.c_str());
+	if (port < 0 || port > 3) {
+		res.status = 400;
+		res.set_content("{\"error\":\"Invalid controller port. Must be 0-3\"}", "application/json");
+		return std::nullopt;
+	}
+
+	return port;
+}
+
+std::vector<std::string> HTTPServer::ParseWatchNames(const std::string& names_param) {
+	// Parse the names (assuming comma-separated values)
+	std::vector<std::string> names;
+	std::stringstream ss(names_param);
+	std::string name;
+
+	while (getline(ss, name, ',')) {
+		names.push_back(name);
+	}
+	return names;
+}
+
 std::optional<nlohmann::json_abi_v3_12_0::json> HTTPServer::ParseJson(std::string rawBody) {
 	nlohmann::json json_data;
 	bool json_parse_success = false;
@@ -392,6 +863,27 @@ std::optional<nlohmann::json_abi_v3_12_0::json> HTTPServer::ParseJson(std::strin
 	return nlohmann::json::parse(rawBody);
 }
 
+// [emubench] Converts a predicate operand to the raw bits of the watch's type (see MemoryWatch)
+static std::optional<u64> ParseWatchOperand(const nlohmann::json& operand, WatchType type, u32 size) {
+	if (!operand.is_number()) {
+		return std::nullopt;
+	}
+
+	const u64 width_mask = size >= 8 ? ~u64{0} : (u64{1} << (size * 8)) - 1;
+	switch (type) {
+	case WatchType::F32: return std::bit_cast<u32>(operand.get<float>());
+	case WatchType::F64: return std::bit_cast<u64>(operand.get<double>());
+	default:
+		if (operand.is_number_float()) {
+			return std::nullopt;
+		}
+		if (operand.is_number_unsigned()) {
+			return operand.get<u64>() & width_mask;
+		}
+		return static_cast<u64>(operand.get<s64>()) & width_mask;
+	}
+}
+
 std::vector<std::string> HTTPServer::SetupMemWatchesFromJSON(const nlohmann::json& watches_json) {
 	std::vector<std::string> names;
 	for (auto& watch : watches_json.items()) {
@@ -400,79 +892,417 @@ std::vector<std::string> HTTPServer::SetupMemWatchesFromJSON(const nlohmann::jso
 			return {};
 		}
 		std::string address = watch.value()["address"].get<std::string>();
+		if (!ParseWatchAddress(address)) {
+			NOTICE_LOG_FMT(CORE, "IPC: Invalid address {} for watch {}", address, watch.key());
+			return {};
+		}
+
+		// [emubench] Optional value type for typed/binary reads; numeric types imply their size
+		WatchType type = WatchType::Bytes;
+		if (watch.value().contains("type") && watch.value()["type"].is_string()) {
+			std::optional<WatchType> parsed_type = ParseWatchType(watch.value()["type"].get<std::string>());
+			if (!parsed_type) {
+				NOTICE_LOG_FMT(CORE, "IPC: Unknown type for watch {}", watch.key());
+				return {};
+			}
+			type = *parsed_type;
+		}
 
-		if (!watch.value().contains("size") || !watch.value()["size"].is_number()) {
+		int size = GetWatchTypeSize(type);
+		if (watch.value().contains("size") && watch.value()["size"].is_number()) {
+			size = watch.value()["size"].get<int>();
+		}
+		if (size <= 0 || (type != WatchType::Bytes && static_cast<u32>(size) != GetWatchTypeSize(type))) {
 			NOTICE_LOG_FMT(CORE, "IPC: Failed to read size for watch {}", watch.key());
 			return {};
 		}
-		int size = watch.value()["size"].get<int>();
+
+		// [emubench] Watches are read when requested unless they ask to be refreshed every frame
+		WatchTrigger trigger = WatchTrigger::OnDemand;
+		if (watch.value().contains("trigger") && watch.value()["trigger"].is_string()) {
+			std::optional<WatchTrigger> parsed_trigger = ParseWatchTrigger(watch.value()["trigger"].get<std::string>());
+			if (!parsed_trigger) {
+				NOTICE_LOG_FMT(CORE, "IPC: Unknown trigger for watch {}", watch.key());
+				return {};
+			}
+			trigger = *parsed_trigger;
+		}
+
+		// [emubench] Optional predicate, recorded as an event on the frame it becomes true
+		WatchPredicate predicate = WatchPredicate::None;
+		u64 operand = 0;
+		u64 mask = ~u64{0};
+		if (watch.value().contains("predicate") && watch.value()["predicate"].is_string()) {
+			std::optional<WatchPredicate> parsed_predicate = ParseWatchPredicate(watch.value()["predicate"].get<std::string>());
+			if (!parsed_predicate || (*parsed_predicate != WatchPredicate::Change && size > 8)) {
+				NOTICE_LOG_FMT(CORE, "IPC: Invalid predicate for watch {}", watch.key());
+				return {};
+			}
+			predicate = *parsed_predicate;
+
+			if (predicate == WatchPredicate::Mask) {
+				std::optional<u64> parsed_mask = watch.value().contains("mask") ?
+					ParseWatchOperand(watch.value()["mask"], WatchType::Bytes, size) : std::nullopt;
+				if (!parsed_mask) {
+					NOTICE_LOG_FMT(CORE, "IPC: Failed to read mask for watch {}", watch.key());
+					return {};
+				}
+				mask = *parsed_mask;
+				// Without a value, fire when every bit in the mask is set
+				operand = mask;
+			}
+
+			if (predicate != WatchPredicate::Change && watch.value().contains("value")) {
+				std::optional<u64> parsed_operand = ParseWatchOperand(watch.value()["value"], type, size);
+				if (!parsed_operand) {
+					NOTICE_LOG_FMT(CORE, "IPC: Failed to read value for watch {}", watch.key());
+					return {};
+				}
+				operand = *parsed_operand;
+			} else if (predicate == WatchPredicate::Equals || predicate == WatchPredicate::GreaterThan) {
+				NOTICE_LOG_FMT(CORE, "IPC: Missing value for watch {}", watch.key());
+				return {};
+			}
+		}
 
 		std::optional<std::vector<u32>> offsets = std::nullopt;
 		if (watch.value().contains("offsets") && watch.value()["offsets"].is_array()) {
 			offsets = watch.value()["offsets"].get<std::vector<u32>>();
 		}
 
-		std::optional<std::string> current_value = std::nullopt;
-
 		MemoryWatch mw;
 		mw.address = address;
 		mw.offsets = offsets;
 		mw.size = size;
-		mw.current_value = current_value;
+		mw.type = type;
+		mw.trigger = trigger;
+		mw.predicate = predicate;
+		mw.operand = operand;
+		mw.mask = mask;
 
-		IPC::MemWatcher::GetInstance().WatchAddress(watch.key(), mw);
+		if (!IPC::MemWatcher::GetInstance().WatchAddress(watch.key(), mw)) {
+			return {};
+		}
 		names.push_back(watch.key());
 	}
 	return names;
 }
 
+// [emubench] Reads end-state and context watches from guest memory in one CPU-thread job
+bool HTTPServer::RefreshEpisodeWatches() {
+	std::vector<std::string> names = m_end_state_watch_names;
+	names.insert(names.end(), m_context_watch_names.begin(), m_context_watch_names.end());
+	return IPC::MemWatcher::GetInstance().RefreshValues(names);
+}
+
+// Returns the last values read; call MemWatcher::RefreshValues (or RefreshEpisodeWatches) first
 std::map<std::string, std::string> HTTPServer::ReadMemWatches(std::vector<std::string> watch_names) {
 	std::map<std::string, std::string> results;
-	for (const auto& watch_name : watch_names) {
-		std::optional<std::string> value = IPC::MemWatcher::GetInstance().FetchValue(watch_name);
-		if (value.has_value()) {
-			results[watch_name] = value.value();
+	std::vector<std::optional<WatchValue>> values = IPC::MemWatcher::GetInstance().FetchValues(watch_names);
+	for (size_t i = 0; i < watch_names.size(); ++i) {
+		if (values[i].has_value()) {
+			results[watch_names[i]] = values[i]->ToHex();
 		} else {
-			NOTICE_LOG_FMT(CORE, "IPC: Failed to read value for watch {}", watch_name);
+			NOTICE_LOG_FMT(CORE, "IPC: Failed to read value for watch {}", watch_names[i]);
 		}
 	}
 	return results;
 }
 
-void HTTPServer::AdvanceFrame() {
-	HTTPServer::m_frame_count++;
+// [emubench] Numeric watches become JSON numbers, byte watches stay hex strings, invalid reads are null
+static nlohmann::json WatchValueToJson(const WatchValue& value) {
+	if (!value.valid) {
+		return nullptr;
+	}
+
+	const u8* bytes = value.bytes.data();
+	switch (value.type) {
+	case WatchType::U8: return bytes[0];
+	case WatchType::U16: return Common::swap16(bytes);
+	case WatchType::U32: return Common::swap32(bytes);
+	case WatchType::U64: return Common::swap64(bytes);
+	case WatchType::S8: return static_cast<s8>(bytes[0]);
+	case WatchType::S16: return static_cast<s16>(Common::swap16(bytes));
+	case WatchType::S32: return static_cast<s32>(Common::swap32(bytes));
+	case WatchType::S64: return static_cast<s64>(Common::swap64(bytes));
+	case WatchType::F32: return std::bit_cast<float>(Common::swap32(bytes));
+	case WatchType::F64: return std::bit_cast<double>(Common::swap64(bytes));
+	default: return value.ToHex();
+	}
+}
+
+// Returns the last values read, like ReadMemWatches
+nlohmann::json HTTPServer::ReadMemWatchesTyped(const std::vector<std::string>& watch_names) {
+	nlohmann::json results = nlohmann::json::object();
+	std::vector<std::optional<WatchValue>> values = IPC::MemWatcher::GetInstance().FetchValues(watch_names);
+	for (size_t i = 0; i < watch_names.size(); ++i) {
+		if (values[i].has_value()) {
+			results[watch_names[i]] = WatchValueToJson(*values[i]);
+		}
+	}
+	return results;
+}
+
+nlohmann::json HTTPServer::WatchEventToJson(const WatchEvent& event) {
+	return {
+		{"sequence", event.sequence},
+		{"frame", event.frame},
+		{"name", event.name},
+		{"value", event.value.ToHex()},
+		{"typedValue", WatchValueToJson(event.value)}
+	};
+}
+
+// [emubench] Binary memwatch layout, per requested name in order:
+//   u8 valid, u8 type (WatchType), u16 size (little-endian), then `size` value bytes.
+// Numeric types are converted to little-endian; byte watches are sent in guest order.
+// Unknown names are sent as invalid with size 0. Returns the last values read, like ReadMemWatches.
+std::string HTTPServer::ReadMemWatchesBinary(const std::vector<std::string>& watch_names) {
+	std::string out;
+	std::vector<std::optional<WatchValue>> values = IPC::MemWatcher::GetInstance().FetchValues(watch_names);
+	for (const std::optional<WatchValue>& value : values) {
+		const u16 size = value ? static_cast<u16>(value->bytes.size()) : 0;
+		out.push_back(value && value->valid ? 1 : 0);
+		out.push_back(static_cast<char>(value ? value->type : WatchType::Bytes));
+		out.push_back(static_cast<char>(size & 0xFF));
+		out.push_back(static_cast<char>(size >> 8));
+		if (!value) {
+			continue;
+		}
 
+		if (value->type == WatchType::Bytes) {
+			out.append(value->bytes.begin(), value->bytes.end());
+		} else {
+			out.append(value->bytes.rbegin(), value->bytes.rend());
+		}
+	}
+	return out;
+}
+
+void HTTPServer::AdvanceFrame() {
 	// Advance frame counters for timed IPC inputs - must be synchronized with HTTPServer frame counter
 	for (int i = 0; i < 4; ++i) {
 		Pad::AdvanceFrame(i);
 	}
 
-	if (HTTPServer::m_waiting && HTTPServer::m_frame_count >= HTTPServer::m_frame_event) {
-		HTTPServer::m_waiting = false;
-		HTTPServer::m_wait_frames_promise.set_value();
+	HTTPServer::StepBatch();
+
+	// Wake waiters last so anything they read (inputs, batch observations) is already up to date
+	m_frame_barrier.Advance();
+}
+
+std::optional<HTTPServer::BatchResult> HTTPServer::RunBatch(int port, std::vector<IPCBatchStep> steps, std::vector<std::string> stop_on,
+                                                            std::optional<ObservationParams> observation) {
+	{
+		std::lock_guard<std::mutex> lk(m_batch_lock);
+		if (m_batch_claimed) {
+			NOTICE_LOG_FMT(CORE, "IPC: Rejecting batch for pad {}, another batch is running", port);
+			return std::nullopt;
+		}
+		m_batch_claimed = true;
+
+		NOTICE_LOG_FMT(CORE, "IPC: Running batch of {} steps for pad {}", steps.size(), port);
+		m_batch_port = port;
+		m_batch_steps = std::move(steps);
+		m_batch_observation_params = observation;
+		m_batch_capture_lead = GetCaptureLead(observation);
+		m_batch_observations.clear();
+		m_batch_observations.resize(m_batch_steps.size());
+		m_batch_pending_observations.clear();
+		m_batch_screenshot_events.clear();
+
+		// Names are assigned up front so the frame callback never touches m_screenshot_count
+		for (size_t i = 0; i < m_batch_steps.size(); ++i) {
+			if (m_batch_steps[i].capture_frame && g_frame_dumper) {
+				m_batch_observations[i].screenshot = std::to_string(m_screenshot_count++);
+			}
+			m_batch_screenshot_events.push_back(std::make_unique<Common::Event>());
+		}
+
+		// Only predicates that fire from here on can stop this batch
+		m_batch_stop_on = std::move(stop_on);
+		m_batch_stop_sequence = IPC::MemWatcher::GetInstance().GetNextEventSequence();
+		m_batch_stopped_by = std::nullopt;
+
+		m_batch_done.Reset();
+		m_batch_index = 0;
+		StartBatchStep();
+		m_batch_active = true;
+	}
+
+	// If turn-based, play the game
+	Core::System& system = Core::System::GetInstance();
+	if (!m_real_time) {
+		Core::SetState(system, Core::State::Running);
+	}
+
+	m_batch_done.Wait();
+
+	if (!m_real_time) {
+		Core::SetState(system, Core::State::Paused);
 	}
+
+	// Take the results so the captures can be waited for without holding up the frame callback
+	BatchResult result;
+	std::vector<std::unique_ptr<Common::Event>> screenshot_events;
+	{
+		std::lock_guard<std::mutex> lk(m_batch_lock);
+		result = {std::move(m_batch_observations), std::move(m_batch_stopped_by)};
+		screenshot_events = std::move(m_batch_screenshot_events);
+	}
+
+	for (size_t i = 0; i < result.observations.size(); ++i) {
+		// Captures are handed to the dump thread two frames before the step ends, so they are
+		// normally done by now; don't hang the request if the dumper dropped one
+		std::optional<std::string>& screenshot = result.observations[i].screenshot;
+		if (!screenshot || screenshot_events[i]->WaitFor(std::chrono::seconds(5))) {
+			continue;
+		}
+
+		// The dumper must not set the event after it is freed below. If the request is already gone
+		// the capture may have finished just now.
+		const bool cancelled = g_frame_dumper && g_frame_dumper->CancelScreenshot(screenshot_events[i].get());
+		if (cancelled || !screenshot_events[i]->WaitFor(std::chrono::seconds(0))) {
+			NOTICE_LOG_FMT(CORE, "IPC: Batch screenshot {} timed out", *screenshot);
+			screenshot = std::nullopt;
+		}
+	}
+
+	NOTICE_LOG_FMT(CORE, "IPC: Batch of {} steps finished at frame {}", result.observations.size(), m_frame_barrier.GetFrame());
+
+	std::lock_guard<std::mutex> lk(m_batch_lock);
+	m_batch_claimed = false;
+	return result;
 }
 
-void HTTPServer::WaitXFrames(uint32_t frames) {
-	if (frames == 0) {
+// Called with m_batch_lock held
+void HTTPServer::StartBatchStep() {
+	const IPCBatchStep& step = m_batch_steps[m_batch_index];
+	Pad::QueueTimedInput(m_batch_port, ConvertToGCPadStatus(step.input), step.input.frames);
+	m_batch_frames_left = step.input.frames;
+	QueueBatchScreenshotIfDue();
+}
+
+// Called with m_batch_lock held
+void HTTPServer::QueueBatchScreenshotIfDue() {
+	const BatchObservation& observation = m_batch_observations[m_batch_index];
+	if (m_batch_frames_left != m_batch_capture_lead || !observation.screenshot || !g_frame_dumper) {
+		return;
+	}
+
+	HTTPServer::QueueScreenshot(*observation.screenshot, m_batch_screenshot_events[m_batch_index].get(), m_batch_observation_params);
+}
+
+// Called with m_batch_lock held, on the CPU thread
+void HTTPServer::RecordBatchObservation(size_t index, long long frame) {
+	BatchObservation& observation = m_batch_observations[index];
+	observation.frame = frame;
+	observation.watches_stale = !HTTPServer::RefreshEpisodeWatches();
+	observation.end_state_watches = HTTPServer::ReadMemWatches(m_end_state_watch_names);
+	observation.context_watches = HTTPServer::ReadMemWatches(m_context_watch_names);
+}
+
+// Runs on the CPU thread after every frame's memwatch predicates. Reads the watches of steps that
+// ended on the GPU thread since the last frame, then checks "stopOn".
+void HTTPServer::OnBatchCPUFrameEnd() {
+	std::lock_guard<std::mutex> lk(m_batch_lock);
+	if (!m_batch_pending_observations.empty()) {
+		// The frame counter advances on the GPU thread, which is behind the CPU in dual core
+		for (size_t index : m_batch_pending_observations) {
+			RecordBatchObservation(index, m_frame_barrier.GetFrame());
+		}
+		m_batch_pending_observations.clear();
+
+		// StepBatch leaves finishing a batch whose last observation was pending to us
+		if (!m_batch_active) {
+			m_batch_done.Set();
+			return;
+		}
+	}
+
+	StopBatchIfTriggered();
+}
+
+// Called with m_batch_lock held, on the CPU thread. Ends the batch on this frame, partway through
+// the current step if need be, if a "stopOn" watch fired.
+void HTTPServer::StopBatchIfTriggered() {
+	if (!m_batch_active || m_batch_stop_on.empty()) {
 		return;
 	}
 
-	HTTPServer::m_frame_event = HTTPServer::m_frame_count + frames;
-	if (HTTPServer::m_frame_count >= HTTPServer::m_frame_event) {
+	std::vector<WatchEvent> events = IPC::MemWatcher::GetInstance().GetEvents(m_batch_stop_sequence, m_batch_stop_on);
+	if (events.empty()) {
 		return;
 	}
 
-	HTTPServer::m_wait_frames_promise = std::promise<void>();
-	std::future<void> wait_frames_future = HTTPServer::m_wait_frames_promise.get_future();
+	NOTICE_LOG_FMT(CORE, "IPC: Batch stopped at step {} by watch {}", m_batch_index, events.front().name);
+	m_batch_stopped_by = std::move(events.front());
+	Pad::ClearTimedInputs(m_batch_port);
+
+	// Turn-based mode pauses once the batch ends, so a capture the dumper hasn't finished would
+	// never get its frame. One that was never handed over would never start.
+	BatchObservation& observation = m_batch_observations[m_batch_index];
+	if (observation.screenshot) {
+		const bool queued = m_batch_frames_left <= m_batch_capture_lead;
+		if (!queued || (g_frame_dumper && g_frame_dumper->CancelScreenshot(m_batch_screenshot_events[m_batch_index].get()))) {
+			observation.screenshot = std::nullopt;
+		}
+	}
 
-	HTTPServer::m_waiting = true;
+	RecordBatchObservation(m_batch_index, m_batch_stopped_by->frame);
+	m_batch_observations.resize(m_batch_index + 1);
 
-	if (HTTPServer::m_frame_count >= HTTPServer::m_frame_event) {
-		HTTPServer::m_waiting = false;
+	m_batch_active = false;
+	m_batch_done.Set();
+}
+
+void HTTPServer::StepBatch() {
+	std::lock_guard<std::mutex> lk(m_batch_lock);
+	if (!m_batch_active) {
 		return;
 	}
-	wait_frames_future.wait();
+
+	m_batch_frames_left--;
+	if (m_batch_frames_left > 0) {
+		QueueBatchScreenshotIfDue();
+		return;
+	}
+
+	if (Core::IsCPUThread()) {
+		// The barrier advances after this callback, so this step ends on the next frame number
+		RecordBatchObservation(m_batch_index, m_frame_barrier.GetFrame() + 1);
+	} else {
+		m_batch_pending_observations.push_back(m_batch_index);
+	}
+
+	m_batch_index++;
+	if (m_batch_index < m_batch_steps.size()) {
+		StartBatchStep();
+		return;
+	}
+
+	m_batch_active = false;
+	if (m_batch_pending_observations.empty()) {
+		m_batch_done.Set();
+	}
+}
+
+void HTTPServer::WaitXFrames(uint32_t frames) {
+	if (frames == 0) {
+		return;
+	}
+
+	m_frame_barrier.WaitForFrame(m_frame_barrier.GetFrame() + frames);
+}
+
+bool HTTPServer::WaitXFramesWhileRunning(uint32_t frames) {
+	const u64 target = m_frame_barrier.GetFrame() + frames;
+	while (!m_frame_barrier.WaitForFrame(target, std::chrono::seconds(1))) {
+		if (Core::GetState(Core::System::GetInstance()) == Core::State::Uninitialized) {
+			return false;
+		}
+	}
+	return true;
 }
 
 void HTTPServer::SetupTest() {
@@ -490,6 +1320,8 @@ void HTTPServer::SetupTest() {
 	Core::System& system = Core::System::GetInstance();
 	Core::SetState(system, Core::State::Paused);
 	m_frame_end_handle = AfterFrameEvent::Register([this](Core::System&) { HTTPServer::AdvanceFrame(); }, "HTTPServerFrameCounter");
+	IPC::MemWatcher::GetInstance().SetFrameSource([this] { return m_frame_barrier.GetFrame(); });
+	IPC::MemWatcher::GetInstance().SetStepCallback([this](const Core::CPUThreadGuard&) { HTTPServer::OnBatchCPUFrameEnd(); });
 
 	NOTICE_LOG_FMT(CORE, "IPC: Setting up test");
 	// Startup values
@@ -517,6 +1349,9 @@ void HTTPServer::SetupTest() {
 
 	HTTPServer::UploadScreenshotToGcp(initialScreenshot);
 
+	if (!HTTPServer::RefreshEpisodeWatches()) {
+		NOTICE_LOG_FMT(CORE, "IPC: Initial memwatch values may be stale");
+	}
 	m_initial_end_state_watches = HTTPServer::ReadMemWatches(m_end_state_watch_names);
 	NOTICE_LOG_FMT(CORE, "IPC: Initial endState memwatches: {}", m_initial_end_state_watches.size());
 
@@ -553,16 +1388,14 @@ std::string HTTPServer::SaveNextScreenshot() {
 		}
 
 		// Set up the screenshot request
-		g_frame_dumper->SaveScreenshotWithCallback(
-			File::GetUserPath(D_SCREENSHOTS_IDX) + screenshot_name + ".png",
-			&completion_event
-		);
+		HTTPServer::QueueScreenshot(screenshot_name, &completion_event);
 
 		// Wait for 2 frames to ensure:
 		// - Frame 1: ProcessFrameDumping() captures the current frame
 		// - Frame 2: FlushFrameDump() processes and kicks the dump thread
 		// Do NOT kick the thread directly - let the normal frame flow handle it
-		HTTPServer::WaitXFrames(2);
+		// With render skipping, the warm-up frames come first
+		HTTPServer::WaitXFrames(GetCaptureLead(std::nullopt));
 
 		if (was_paused) {
 			Core::SetState(system, Core::State::Paused);
@@ -574,11 +1407,87 @@ std::string HTTPServer::SaveNextScreenshot() {
 	return screenshot_name;
 }
 
+// [emubench] Stacked observations start capturing one frame earlier per extra frame. With
+// render skipping, the capture waits for RenderSkip::WARMUP_FRAMES rendered frames first, so it
+// is queued that much earlier to land on the same frame.
+uint32_t HTTPServer::GetCaptureLead(const std::optional<ObservationParams>& observation) {
+	const uint32_t warmup = Config::Get(Config::GFX_HACK_SKIP_UNOBSERVED_FRAMES) ? RenderSkip::WARMUP_FRAMES : 0;
+	return SCREENSHOT_PIPELINE_FRAMES + warmup + (observation ? observation->stack - 1 : 0);
+}
+
+// [emubench] Hands the next dumped frame to the file or in-memory screenshot path
+void HTTPServer::QueueScreenshot(const std::string& screenshot_name, Common::Event* completion_event,
+                                 const std::optional<ObservationParams>& observation) {
+	IPC::ScreenshotStore& store = IPC::ScreenshotStore::GetInstance();
+	if (store.GetMode() == ScreenshotMode::Memory) {
+		g_frame_dumper->CaptureFrameWithCallback(store.Allocate(screenshot_name), completion_event,
+		                                         observation.value_or(ObservationParams{}));
+	} else {
+		g_frame_dumper->SaveScreenshotWithCallback(File::GetUserPath(D_SCREENSHOTS_IDX) + screenshot_name + ".png", completion_event);
+	}
+}
+
+static std::string EncodeBase64(const std::vector<u8>& data) {
+	static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string out;
+	out.reserve((data.size() + 2) / 3 * 4);
+	size_t i = 0;
+	for (; i + 2 < data.size(); i += 3) {
+		const u32 triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+		out.push_back(alphabet[(triple >> 18) & 0x3F]);
+		out.push_back(alphabet[(triple >> 12) & 0x3F]);
+		out.push_back(alphabet[(triple >> 6) & 0x3F]);
+		out.push_back(alphabet[triple & 0x3F]);
+	}
+	if (i < data.size()) {
+		const u32 triple = (data[i] << 16) | (i + 1 < data.size() ? data[i + 1] << 8 : 0);
+		out.push_back(alphabet[(triple >> 18) & 0x3F]);
+		out.push_back(alphabet[(triple >> 12) & 0x3F]);
+		out.push_back(i + 1 < data.size() ? alphabet[(triple >> 6) & 0x3F] : '=');
+		out.push_back('=');
+	}
+	return out;
+}
+
+// [emubench] In-memory screenshot as {"encoding", "width", "height", "channels", "layers",
+// "data" (base64)} for responses
+std::optional<nlohmann::json> HTTPServer::InlineScreenshot(const std::string& screenshot_name) {
+	std::shared_ptr<const CapturedFrame> frame = IPC::ScreenshotStore::GetInstance().Get(screenshot_name);
+	if (!frame) {
+		return std::nullopt;
+	}
+
+	const ScreenshotEncoding encoding = IPC::ScreenshotStore::GetInstance().GetEncoding();
+	std::optional<std::vector<u8>> encoded = IPC::ScreenshotStore::Encode(*frame, encoding);
+	if (!encoded) {
+		return std::nullopt;
+	}
+
+	return nlohmann::json{
+		{"encoding", GetScreenshotExtension(encoding) + 1},
+		{"width", frame->width},
+		{"height", frame->height},
+		{"channels", frame->channels},
+		{"layers", frame->layers},
+		{"data", EncodeBase64(*encoded)}
+	};
+}
+
 bool HTTPServer::UploadScreenshotToGcp(std::string screenshot_name) {
 	const char* testId = std::getenv("TEST_ID");
 	if (testId) {
-		std::string screenshot_path = File::GetUserPath(D_SCREENSHOTS_IDX) + screenshot_name + ".png";
-		bool upload_success = m_firestore_client->postScreenshot(screenshot_path, testId);
+		bool upload_success = false;
+		if (std::shared_ptr<const CapturedFrame> frame = IPC::ScreenshotStore::GetInstance().Get(screenshot_name)) {
+			// Captured in memory: encode and upload straight from the frame buffer
+			const ScreenshotEncoding encoding = IPC::ScreenshotStore::GetInstance().GetEncoding();
+			std::optional<std::vector<u8>> encoded = IPC::ScreenshotStore::Encode(*frame, encoding);
+			upload_success = encoded && m_firestore_client->postScreenshotData(
+				screenshot_name + GetScreenshotExtension(encoding), reinterpret_cast<const char*>(encoded->data()),
+				encoded->size(), GetScreenshotContentType(encoding), testId);
+		} else {
+			std::string screenshot_path = File::GetUserPath(D_SCREENSHOTS_IDX) + screenshot_name + ".png";
+			upload_success = m_firestore_client->postScreenshot(screenshot_path, testId);
+		}
 		if (upload_success) {
 			NOTICE_LOG_FMT(CORE, "IPC: Screenshot uploaded to GCS successfully");
 		} else {
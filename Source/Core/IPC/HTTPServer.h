@@ -1,15 +1,20 @@
 // HTTPServer.h
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <thread>
 #include <atomic>
+#include <bit>
 #include <optional>
 #include <iostream>
 #include <future>
 #include <chrono>
 #include <thread>
+#include <map>
+#include <mutex>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 #include "httplib.h"
@@ -22,24 +27,32 @@
 #include "Common/Random.h"
 #include "Common/WindowSystemInfo.h"
 #include "Common/HookableEvent.h"
+#include "Common/Swap.h"
 
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
 #include "Core/HW/GCPad.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
 
 #include "DolphinQt/MainWindow.h"
 
+#include "IPC/BlockProfiler.h"
 #include "IPC/ControllerCommands.h"
+#include "IPC/FrameBarrier.h"
 #include "IPC/MemWatcher.h"
 #include "IPC/SaveState.h"
+#include "IPC/ScreenshotStore.h"
 #include "IPC/GcpClient.h"
 
 #include "InputCommon/GCPadStatus.h"
 
 #include "VideoCommon/VideoEvents.h"
 #include "VideoCommon/FrameDumper.h"
+#include "VideoCommon/RenderSkip.h"
 
 namespace IPC {
 
@@ -63,9 +76,10 @@ public:
     Common::EventHook m_frame_end_handle;
     bool m_real_time;
     int m_screenshot_count = 0;
-    long long m_frame_count = 0;
-    long long m_frame_event = 0;
-    std::promise<void> m_wait_frames_promise;
+    FrameBarrier m_frame_barrier;
+
+    // [emubench] Like WaitXFrames, but gives up and returns false once emulation has shut down
+    bool WaitXFramesWhileRunning(uint32_t frames);
 
 private:
     explicit HTTPServer(MainWindow* window = nullptr);
@@ -80,19 +94,84 @@ private:
     std::unique_ptr<std::thread> m_thread;
     std::optional<nlohmann::json_abi_v3_12_0::json> ParseJson(std::string rawBody);
 
+    std::optional<int> ParseControllerPort(const httplib::Request& req, httplib::Response& res);
+    std::vector<std::string> ParseWatchNames(const std::string& names_param);
+    bool RefreshEpisodeWatches();
     std::map<std::string, std::string> ReadMemWatches(std::vector<std::string> watch_names);
+    nlohmann::json ReadMemWatchesTyped(const std::vector<std::string>& watch_names);
+    std::string ReadMemWatchesBinary(const std::vector<std::string>& watch_names);
+    nlohmann::json WatchEventToJson(const WatchEvent& event);
     std::vector<std::string> SetupMemWatchesFromJSON(const nlohmann::json_abi_v3_12_0::json& json_data);
     void SetupTest();
     void AdvanceFrame();
     void WaitXFrames(uint32_t frames);
     std::string SaveNextScreenshot();
+    void QueueScreenshot(const std::string& screenshot_name, Common::Event* completion_event,
+                         const std::optional<ObservationParams>& observation = std::nullopt);
+    std::optional<nlohmann::json> InlineScreenshot(const std::string& screenshot_name);
+
+    // [emubench] Batched multi-step execution. The HTTP thread hands the steps to StepBatch, which
+    // runs from AdvanceFrame and counts off each step's frames. Observations are always read on the
+    // CPU thread, by OnBatchCPUFrameEnd, so every watch is current: inline when StepBatch itself
+    // runs there (single core), otherwise at the CPU's next frame boundary. "stopOn" watches are
+    // checked there too, right after their predicates.
+    struct BatchObservation {
+        // Frame the watches were read on. With dual core this can be a frame after the step ended.
+        long long frame = 0;
+        std::map<std::string, std::string> end_state_watches;
+        std::map<std::string, std::string> context_watches;
+        // The watches couldn't be re-read and hold older values
+        bool watches_stale = false;
+        std::optional<std::string> screenshot;
+    };
+    static constexpr uint32_t BATCH_MINIMUM_FRAMES = 2;
+    static constexpr uint32_t SCREENSHOT_PIPELINE_FRAMES = 2;
+    // Frames between queueing a capture and the end of the step
+    static uint32_t GetCaptureLead(const std::optional<ObservationParams>& observation);
+    // Longest a memwatch event request (or one stream poll) blocks waiting for an event
+    static constexpr long long MAX_EVENT_WAIT_MS = 15000;
+
+    struct BatchResult {
+        std::vector<BatchObservation> observations;
+        // Set when a "stopOn" watch fired and the remaining steps were skipped
+        std::optional<WatchEvent> stopped_by;
+    };
+
+    // Returns std::nullopt without running anything if another batch is still in progress
+    std::optional<BatchResult> RunBatch(int port, std::vector<IPCBatchStep> steps, std::vector<std::string> stop_on = {},
+                         std::optional<ObservationParams> observation = std::nullopt);
+    void StartBatchStep();
+    void QueueBatchScreenshotIfDue();
+    void RecordBatchObservation(size_t index, long long frame);
+    void OnBatchCPUFrameEnd();
+    void StopBatchIfTriggered();
+    void StepBatch();
     bool UploadScreenshotToGcp(std::string screenshot_name);
 
     std::map<std::string, std::string> m_initial_end_state_watches = {};
     std::map<std::string, std::string> m_initial_context_watches = {};
     std::vector<std::string> m_end_state_watch_names;
     std::vector<std::string> m_context_watch_names;
-    bool m_waiting;
+
+    std::mutex m_batch_lock;
+    // Set from the start of RunBatch until it has collected its results
+    bool m_batch_claimed = false;
+    bool m_batch_active = false;
+    int m_batch_port = 0;
+    size_t m_batch_index = 0;
+    uint32_t m_batch_frames_left = 0;
+    std::vector<IPCBatchStep> m_batch_steps;
+    std::vector<BatchObservation> m_batch_observations;
+    // Steps that ended off the CPU thread and wait for OnBatchCPUFrameEnd to read their watches
+    std::vector<size_t> m_batch_pending_observations;
+    std::vector<std::string> m_batch_stop_on;
+    u64 m_batch_stop_sequence = 0;
+    std::optional<WatchEvent> m_batch_stopped_by;
+    std::optional<ObservationParams> m_batch_observation_params;
+    // Frames before the end of a step at which its capture is queued
+    uint32_t m_batch_capture_lead = SCREENSHOT_PIPELINE_FRAMES;
+    std::vector<std::unique_ptr<Common::Event>> m_batch_screenshot_events;
+    Common::Event m_batch_done;
     std::unique_ptr<GcpClient> m_firestore_client;
 };
 
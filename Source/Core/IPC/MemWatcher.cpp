@@ -1,10 +1,18 @@
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
 #include <cstring>
 #include <fstream>
+#include <memory>
 #include <iostream>
-#include <sstream>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
+#include "Common/Event.h"
 #include "Common/FileUtil.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/Core.h"
@@ -14,138 +22,551 @@
 
 namespace IPC {
 
+std::optional<WatchType> ParseWatchType(std::string_view name)
+{
+  static const std::map<std::string_view, WatchType> types = {
+      {"bytes", WatchType::Bytes}, {"u8", WatchType::U8},   {"u16", WatchType::U16},
+      {"u32", WatchType::U32},     {"u64", WatchType::U64}, {"s8", WatchType::S8},
+      {"s16", WatchType::S16},     {"s32", WatchType::S32}, {"s64", WatchType::S64},
+      {"f32", WatchType::F32},     {"f64", WatchType::F64},
+  };
+
+  auto it = types.find(name);
+  if (it == types.end())
+    return std::nullopt;
+  return it->second;
+}
+
+std::optional<WatchTrigger> ParseWatchTrigger(std::string_view name)
+{
+  if (name == "demand")
+    return WatchTrigger::OnDemand;
+  if (name == "frame")
+    return WatchTrigger::EveryFrame;
+  return std::nullopt;
+}
+
+std::optional<WatchPredicate> ParseWatchPredicate(std::string_view name)
+{
+  if (name == "change")
+    return WatchPredicate::Change;
+  if (name == "equals")
+    return WatchPredicate::Equals;
+  if (name == "greater")
+    return WatchPredicate::GreaterThan;
+  if (name == "mask")
+    return WatchPredicate::Mask;
+  return std::nullopt;
+}
+
+std::optional<u32> ParseWatchAddress(std::string_view address)
+{
+  if (address.starts_with("0x") || address.starts_with("0X"))
+    address.remove_prefix(2);
+
+  u32 value;
+  const char* end = address.data() + address.size();
+  const auto result = std::from_chars(address.data(), end, value, 16);
+  if (address.empty() || result.ec != std::errc{} || result.ptr != end)
+    return std::nullopt;
+  return value;
+}
+
+u32 GetWatchTypeSize(WatchType type)
+{
+  switch (type)
+  {
+  case WatchType::U8:
+  case WatchType::S8:
+    return 1;
+  case WatchType::U16:
+  case WatchType::S16:
+    return 2;
+  case WatchType::U32:
+  case WatchType::S32:
+  case WatchType::F32:
+    return 4;
+  case WatchType::U64:
+  case WatchType::S64:
+  case WatchType::F64:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+std::string WatchValue::ToHex() const
+{
+  // Invalid watches have always been reported as "0"
+  if (!valid)
+    return "0";
+
+  std::string hex;
+  hex.reserve(bytes.size() * 2);
+  for (u8 byte : bytes)
+    fmt::format_to(std::back_inserter(hex), "{:02X}", byte);
+  return hex;
+}
+
+// Result of a watch's predicate on its last evaluation. Events fire on Unknown/False -> True, so
+// the first evaluation after a watch is (re)registered only sets the baseline.
+enum PredicateState : u8
+{
+  PREDICATE_UNKNOWN,
+  PREDICATE_FALSE,
+  PREDICATE_TRUE,
+};
+
+// Returns a host pointer for `size` bytes at a directly mapped MEM1/MEM2 address, the same ranges
+// Memory::CopyFromEmu accepts, or nullptr (without the panic CopyFromEmu would raise).
+static const u8* GetDirectPointer(Memory::MemoryManager& memory, u32 address, u32 size)
+{
+  const u32 segment = address >> 28;
+  const u64 ram_offset = address & 0x0FFFFFFF;
+
+  if ((segment == 0x0 || segment == 0x8 || segment == 0xC) &&
+      ram_offset + size <= memory.GetRamSizeReal())
+  {
+    return memory.GetRAM() + ram_offset;
+  }
+
+  if (memory.GetEXRAM() && (segment == 0x1 || segment == 0x9 || segment == 0xD) &&
+      ram_offset + size <= memory.GetExRamSizeReal())
+  {
+    return memory.GetEXRAM() + ram_offset;
+  }
+
+  return nullptr;
+}
+
 MemWatcher& MemWatcher::GetInstance() {
   static MemWatcher instance;
   return instance;
 }
 
-void MemWatcher::WatchAddress(std::string name, const MemoryWatch& mw)
+bool MemWatcher::WatchAddress(std::string name, const MemoryWatch& mw)
 {
-  m_memwatches[name] = mw;
-  
+  const std::optional<u32> address = ParseWatchAddress(mw.address);
+  if (!address) {
+    NOTICE_LOG_FMT(CORE, "IPC: Invalid address {} for watch {}", mw.address, name);
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    // A new watch only adds to the compiled arrays; replacing one changes its layout
+    if (m_memwatches.insert_or_assign(name, mw).second)
+      AppendWatch(name, mw, *address);
+    else
+      Compile(name);
+  }
+
   // Queue a job to run on the CPU thread to populate the watch value
   Core::QueueHostJob([this, name](Core::System& system) {
     const Core::CPUThreadGuard guard(system);
 
-    if (m_memwatches.count(name) > 0) {
-      MemoryWatch& mw = m_memwatches[name];
-      UpdateValue(guard, mw);
+    std::lock_guard<std::mutex> lk(m_lock);
+    auto it = m_indices.find(name);
+    if (it != m_indices.end()) {
+      UpdateValue(&guard, system.GetMemory(), it->second);
     }
   }, true);
 }
 
+bool MemWatcher::RefreshValues(const std::vector<std::string>& names)
+{
+  Core::System& system = Core::System::GetInstance();
+
+  // Already on the CPU thread (single core frame callbacks): read inline
+  if (Core::IsCPUThread()) {
+    const Core::CPUThreadGuard guard(system);
+    std::lock_guard<std::mutex> lk(m_lock);
+    for (const std::string& name : names) {
+      auto it = m_indices.find(name);
+      if (it != m_indices.end())
+        UpdateValue(&guard, system.GetMemory(), it->second);
+    }
+    return true;
+  }
+
+  // The GPU thread can't pause the CPU without deadlocking against the FIFO, so only refresh what
+  // can be read directly from MEM1/MEM2
+  if (Core::IsGPUThread()) {
+    std::lock_guard<std::mutex> lk(m_lock);
+    for (const std::string& name : names) {
+      auto it = m_indices.find(name);
+      if (it != m_indices.end())
+        UpdateValue(nullptr, system.GetMemory(), it->second);
+    }
+    return true;
+  }
+
+  if (Core::GetState(system) == Core::State::Uninitialized)
+    return false;
+
+  // Everything else (HTTP threads): one host job reads the whole set under a single CPU pause
+  auto done = std::make_shared<Common::Event>();
+  Core::QueueHostJob([this, names, done](Core::System& job_system) {
+    const Core::CPUThreadGuard guard(job_system);
+
+    std::lock_guard<std::mutex> lk(m_lock);
+    for (const std::string& name : names) {
+      auto it = m_indices.find(name);
+      if (it != m_indices.end())
+        UpdateValue(&guard, job_system.GetMemory(), it->second);
+    }
+    done->Set();
+  }, false);
+
+  // Give up rather than hang a request if the host is busy
+  if (!done->WaitFor(std::chrono::seconds(1))) {
+    NOTICE_LOG_FMT(CORE, "IPC: Timed out refreshing {} memwatches", names.size());
+    return false;
+  }
+  return true;
+}
+
+// Adds one watch to the struct-of-arrays form read by Step, leaving every other watch's value and
+// predicate state as it is. The address was parsed by the caller, once, instead of on every read.
+// Must be called with m_lock held.
+void MemWatcher::AppendWatch(const std::string& name, const MemoryWatch& mw, u32 address)
+{
+  const size_t index = m_names.size();
+  m_indices.emplace(name, index);
+  m_names.push_back(name);
+
+  m_addresses.push_back(address);
+  m_sizes.push_back(mw.size);
+  m_types.push_back(mw.type);
+  if (mw.trigger == WatchTrigger::EveryFrame || mw.predicate != WatchPredicate::None)
+    m_every_frame.push_back(index);
+  if (mw.predicate != WatchPredicate::None)
+    m_predicated.push_back(index);
+  m_predicates.push_back(mw.predicate);
+  m_operands.push_back(mw.operand);
+  m_masks.push_back(mw.mask);
+
+  m_offset_begin.push_back(static_cast<u32>(m_offsets.size()));
+  m_offset_count.push_back(mw.offsets ? static_cast<u32>(mw.offsets->size()) : 0);
+  if (mw.offsets)
+    m_offsets.insert(m_offsets.end(), mw.offsets->begin(), mw.offsets->end());
+
+  m_value_begin.push_back(static_cast<u32>(m_values.size()));
+  m_values.resize(m_values.size() + mw.size, 0);
+  m_valid.push_back(0);
+  m_predicate_states.push_back(PREDICATE_UNKNOWN);
+  if (!m_predicated.empty())
+    m_previous_values.resize(m_values.size(), 0);
+}
+
+// Rebuilds the compiled arrays from m_memwatches after the configuration of watch `replaced` was
+// changed. That watch starts over; every other one keeps its last value and predicate state.
+// Must be called with m_lock held.
+void MemWatcher::Compile(std::string_view replaced)
+{
+  const std::map<std::string, size_t, std::less<>> old_indices = std::move(m_indices);
+  const std::vector<u32> old_value_begin = std::move(m_value_begin);
+  const std::vector<u8> old_values = std::move(m_values);
+  const std::vector<u8> old_valid = std::move(m_valid);
+  const std::vector<u8> old_predicate_states = std::move(m_predicate_states);
+  const std::vector<u8> old_previous_values = std::move(m_previous_values);
+
+  m_names.clear();
+  m_indices.clear();
+  m_addresses.clear();
+  m_sizes.clear();
+  m_types.clear();
+  m_every_frame.clear();
+  m_predicated.clear();
+  m_predicates.clear();
+  m_operands.clear();
+  m_masks.clear();
+  m_offset_begin.clear();
+  m_offset_count.clear();
+  m_offsets.clear();
+  m_value_begin.clear();
+  m_values.clear();
+  m_valid.clear();
+  m_predicate_states.clear();
+  m_previous_values.clear();
+
+  for (const auto& [name, mw] : m_memwatches)
+  {
+    // Every registered address was validated by WatchAddress
+    AppendWatch(name, mw, ParseWatchAddress(mw.address).value_or(0));
+
+    const auto old = old_indices.find(name);
+    if (name == replaced || old == old_indices.end())
+      continue;
+
+    const size_t i = old->second;
+    const size_t index = m_names.size() - 1;
+    std::memcpy(m_values.data() + m_value_begin[index], old_values.data() + old_value_begin[i],
+                mw.size);
+    m_valid[index] = old_valid[i];
+    m_predicate_states[index] = old_predicate_states[i];
+    // Predicated watches always had a slot in m_previous_values, and AppendWatch made one here
+    if (mw.predicate != WatchPredicate::None)
+    {
+      std::memcpy(m_previous_values.data() + m_value_begin[index],
+                  old_previous_values.data() + old_value_begin[i], mw.size);
+    }
+  }
+}
+
 void MemWatcher::UpdateValues(const Core::CPUThreadGuard& guard)
 {
-  for (auto& [name, mw] : m_memwatches)
+  auto& memory = guard.GetSystem().GetMemory();
+
+  std::lock_guard<std::mutex> lk(m_lock);
+  for (size_t i : m_every_frame)
   {
-    UpdateValue(guard, mw);
+    UpdateValue(&guard, memory, i);
   }
+
+  if (!m_predicated.empty())
+    EvaluatePredicates();
+}
+
+// Reinterprets up to 8 big-endian value bytes as the raw bits of the watch's type
+static u64 ReadRawValue(const u8* bytes, u32 size)
+{
+  u64 raw = 0;
+  for (u32 i = 0; i < size; i++)
+    raw = (raw << 8) | bytes[i];
+  return raw;
+}
+
+static s64 SignExtend(u64 raw, u32 size)
+{
+  const u32 shift = 64 - size * 8;
+  return static_cast<s64>(raw << shift) >> shift;
 }
 
-void MemWatcher::UpdateValue(const Core::CPUThreadGuard& guard, MemoryWatch& mw)
+bool MemWatcher::IsPredicateTrue(size_t index) const
 {
-  if (mw.offsets.has_value() && !mw.offsets->empty()) {
-    std::string value = ChasePointer(guard, mw);
-    mw.current_value = std::make_optional(value);
-  } else {
-    u32 address = std::stoul(mw.address, nullptr, 16);
-    if (!PowerPC::MMU::HostIsRAMAddress(guard, address)) {
-      NOTICE_LOG_FMT(CORE, "IPC: Direct address out of bounds: 0x{:08X}", address);
-      mw.current_value = std::make_optional("0");
-      return;
+  const u32 size = m_sizes[index];
+  const u8* value = m_values.data() + m_value_begin[index];
+
+  if (m_predicates[index] == WatchPredicate::Change)
+  {
+    return m_predicate_states[index] != PREDICATE_UNKNOWN &&
+           std::memcmp(value, m_previous_values.data() + m_value_begin[index], size) != 0;
+  }
+
+  const u64 raw = ReadRawValue(value, size);
+  const u64 operand = m_operands[index];
+  switch (m_predicates[index])
+  {
+  case WatchPredicate::Equals:
+    return raw == operand;
+  case WatchPredicate::Mask:
+    return (raw & m_masks[index]) == operand;
+  case WatchPredicate::GreaterThan:
+    switch (m_types[index])
+    {
+    case WatchType::S8:
+    case WatchType::S16:
+    case WatchType::S32:
+    case WatchType::S64:
+      return SignExtend(raw, size) > SignExtend(operand, size);
+    case WatchType::F32:
+      return std::bit_cast<float>(static_cast<u32>(raw)) >
+             std::bit_cast<float>(static_cast<u32>(operand));
+    case WatchType::F64:
+      return std::bit_cast<double>(raw) > std::bit_cast<double>(operand);
+    default:
+      return raw > operand;
     }
-    mw.current_value = std::make_optional(ReadNBytesAsHex(guard, address, mw.size));
+  default:
+    return false;
   }
 }
 
-std::optional<std::string> MemWatcher::FetchValue(const std::string& name)
+// Called with m_lock held, after the frame's values have been read
+void MemWatcher::EvaluatePredicates()
 {
-  return m_memwatches[name].current_value;
+  const u64 frame = m_frame_source ? m_frame_source() : 0;
+  bool fired = false;
+
+  for (size_t i : m_predicated)
+  {
+    // A failed read says nothing about the condition; keep the previous result
+    if (!m_valid[i])
+      continue;
+
+    const bool is_true = IsPredicateTrue(i);
+    // Change fires on every differing frame, the others only on the transition to true
+    if (is_true && (m_predicates[i] == WatchPredicate::Change ||
+                    m_predicate_states[i] == PREDICATE_FALSE))
+    {
+      const u8* begin = m_values.data() + m_value_begin[i];
+      WatchEvent event;
+      event.sequence = m_next_event_sequence++;
+      event.frame = frame;
+      event.name = m_names[i];
+      event.value.type = m_types[i];
+      event.value.valid = true;
+      event.value.bytes.assign(begin, begin + m_sizes[i]);
+      if (m_events.size() == MAX_EVENTS)
+        m_events.pop_front();
+      m_events.push_back(std::move(event));
+      fired = true;
+    }
+
+    m_predicate_states[i] = is_true ? PREDICATE_TRUE : PREDICATE_FALSE;
+    if (m_predicates[i] == WatchPredicate::Change)
+    {
+      std::memcpy(m_previous_values.data() + m_value_begin[i], m_values.data() + m_value_begin[i],
+                  m_sizes[i]);
+    }
+  }
+
+  if (fired)
+    m_event_cv.notify_all();
 }
 
-std::string MemWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const MemoryWatch& mw)
+// `guard` may be null when not called on or with the CPU thread paused; then only directly mapped
+// MEM1/MEM2 can be read and other watches keep their previous value.
+void MemWatcher::UpdateValue(const Core::CPUThreadGuard* guard, Memory::MemoryManager& memory,
+                             size_t index)
 {
-  u32 current_address = std::stoul(mw.address, nullptr, 16);
+  const u32 size = m_sizes[index];
+  u8* dest = m_values.data() + m_value_begin[index];
 
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, current_address)) {
-    NOTICE_LOG_FMT(CORE, "IPC: Initial pointer address out of bounds: 0x{:08X}", current_address);
-    return "0";
+  const std::optional<u32> address = ResolveAddress(guard, memory, index);
+  if (!address) {
+    m_valid[index] = 0;
+    return;
+  }
+
+  if (const u8* src = GetDirectPointer(memory, *address, size)) {
+    std::memcpy(dest, src, size);
+    m_valid[index] = 1;
+    return;
   }
 
-  if (!mw.offsets.has_value()) {
-    // No offsets, just read directly from the address
-    return ReadNBytesAsHex(guard, current_address, mw.size);
+  if (!guard) {
+    return;
   }
-  
+
+  // Not plain MEM1/MEM2 (e.g. fake VMEM or a remapped BAT), go through address translation
+  if (!PowerPC::MMU::HostIsRAMAddress(*guard, *address) ||
+      (size > 1 && !PowerPC::MMU::HostIsRAMAddress(*guard, *address + size - 1))) {
+    NOTICE_LOG_FMT(CORE, "IPC: Read address out of bounds: 0x{:08X}", *address);
+    m_valid[index] = 0;
+    return;
+  }
+
+  for (u32 i = 0; i < size; i++) {
+    dest[i] = PowerPC::MMU::HostRead_U8(*guard, *address + i);
+  }
+  m_valid[index] = 1;
+}
+
+std::optional<u32> MemWatcher::ResolveAddress(const Core::CPUThreadGuard* guard,
+                                              Memory::MemoryManager& memory, size_t index)
+{
+  u32 current_address = m_addresses[index];
+
   // Chase through each offset
-  for (const auto& offset : *mw.offsets) {
-    if (!PowerPC::MMU::HostIsRAMAddress(guard, current_address)) {
-      NOTICE_LOG_FMT(CORE, "IPC: Pointer address out of bounds during chase: 0x{:08X}", current_address);
-      return "0";
-    }
-    
+  const u32* offsets = m_offsets.data() + m_offset_begin[index];
+  for (u32 i = 0; i < m_offset_count[index]; i++) {
     // Read the pointer value at current address
-    u32 pointed_to_address = PowerPC::MMU::HostRead_U32(guard, current_address);
-    
-    // Calculate the next address by adding the offset
-    current_address = pointed_to_address + offset;
-    
-    // Check bounds for the next address
-    if (!PowerPC::MMU::HostIsRAMAddress(guard, current_address)) {
+    u32 pointed_to_address;
+    if (const u8* src = GetDirectPointer(memory, current_address, sizeof(u32))) {
+      pointed_to_address = Common::swap32(src);
+    } else if (guard && PowerPC::MMU::HostIsRAMAddress(*guard, current_address)) {
+      pointed_to_address = PowerPC::MMU::HostRead_U32(*guard, current_address);
+    } else {
       NOTICE_LOG_FMT(CORE, "IPC: Pointer address out of bounds during chase: 0x{:08X}", current_address);
-      return "0";
+      return std::nullopt;
     }
+
+    // Calculate the next address by adding the offset
+    current_address = pointed_to_address + offsets[i];
   }
 
-  return ReadNBytesAsHex(guard, current_address, mw.size);
+  return current_address;
 }
 
-std::string MemWatcher::ReadNBytesAsHex(const Core::CPUThreadGuard& guard, u32 address, u32 size)
+std::optional<std::string> MemWatcher::FetchValue(const std::string& name)
 {
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, address)) {
-    NOTICE_LOG_FMT(CORE, "IPC: Read address out of bounds: 0x{:08X}", address);
-    return "0";
-  }
-  
-  if (size > 1 && !PowerPC::MMU::HostIsRAMAddress(guard, address + size - 1)) {
-    NOTICE_LOG_FMT(CORE, "IPC: Read end address out of bounds: 0x{:08X}", address + size - 1);
-    return "0";
-  }
-  
-  std::stringstream ss;
-  ss << std::hex << std::uppercase << std::setfill('0');
+  std::optional<WatchValue> value = FetchValues({name})[0];
+  if (!value)
+    return std::nullopt;
+  return value->ToHex();
+}
 
-  switch (size) {
-    case 1: { // 1 byte
-      u8 val8 = PowerPC::MMU::HostRead_U8(guard, address);
-      ss << std::setw(2) << static_cast<u32>(val8);
-      break;
-    }
-    case 2: { // 2 bytes
-      u16 val16 = PowerPC::MMU::HostRead_U16(guard, address);
-      ss << std::setw(4) << val16;
-      break;
-    }
-    case 4: { // 4 bytes
-      u32 val32 = PowerPC::MMU::HostRead_U32(guard, address);
-      ss << std::setw(8) << val32;
-      break;
-    }
-    case 8: { // 8 bytes
-      u64 val64 = PowerPC::MMU::HostRead_U64(guard, address);
-      ss << std::setw(16) << val64;
-      break;
+std::vector<std::optional<WatchValue>> MemWatcher::FetchValues(const std::vector<std::string>& names)
+{
+  std::vector<std::optional<WatchValue>> values;
+  values.reserve(names.size());
+
+  std::lock_guard<std::mutex> lk(m_lock);
+  for (const std::string& name : names)
+  {
+    auto it = m_indices.find(name);
+    if (it == m_indices.end())
+    {
+      values.emplace_back(std::nullopt);
+      continue;
     }
-    default: { // For other sizes, read byte by byte
-      for (u32 i = 0; i < size; i++) {
-        u8 val = PowerPC::MMU::HostRead_U8(guard, address + i);
-        ss << std::setw(2) << static_cast<u32>(val);
-      }
-      break;
+
+    const size_t index = it->second;
+    const u8* begin = m_values.data() + m_value_begin[index];
+    WatchValue value;
+    value.type = m_types[index];
+    value.valid = m_valid[index] != 0;
+    value.bytes.assign(begin, begin + m_sizes[index]);
+    values.emplace_back(std::move(value));
+  }
+  return values;
+}
+
+void MemWatcher::SetFrameSource(std::function<u64()> frame_source)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_frame_source = std::move(frame_source);
+}
+
+void MemWatcher::SetStepCallback(std::function<void(const Core::CPUThreadGuard&)> callback)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_step_callback = std::move(callback);
+}
+
+u64 MemWatcher::GetNextEventSequence()
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  return m_next_event_sequence;
+}
+
+std::vector<WatchEvent> MemWatcher::GetEvents(u64 since, const std::vector<std::string>& names,
+                                              std::chrono::milliseconds timeout)
+{
+  const auto collect = [&] {
+    std::vector<WatchEvent> events;
+    for (const WatchEvent& event : m_events)
+    {
+      if (event.sequence < since)
+        continue;
+      if (!names.empty() && std::find(names.begin(), names.end(), event.name) == names.end())
+        continue;
+      events.push_back(event);
     }
+    return events;
+  };
+
+  std::unique_lock<std::mutex> lk(m_lock);
+  std::vector<WatchEvent> events = collect();
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (events.empty() &&
+         m_event_cv.wait_until(lk, deadline) != std::cv_status::timeout)
+  {
+    events = collect();
   }
-  std::string value = ss.str();
-  return value;
+  return events;
 }
 
 void MemWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -155,6 +576,15 @@ void MemWatcher::Step(const Core::CPUThreadGuard& guard)
     m_frames_started.set_value();
   }
   UpdateValues(guard);
+
+  // Called without m_lock, the callback may read watches itself
+  std::function<void(const Core::CPUThreadGuard&)> callback;
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    callback = m_step_callback;
+  }
+  if (callback)
+    callback(guard);
 }
 
 void MemWatcher::ResetFramesStarted()
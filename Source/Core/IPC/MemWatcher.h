@@ -2,17 +2,78 @@
 
 #include "Common/CommonTypes.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
-namespace IPC
+namespace Core
 {
 class CPUThreadGuard;
+}
+
+namespace Memory
+{
+class MemoryManager;
+}
+
+namespace IPC
+{
+
+// [emubench] How a watch's bytes should be interpreted when served as a typed value
+enum class WatchType : u8
+{
+  Bytes,
+  U8,
+  U16,
+  U32,
+  U64,
+  S8,
+  S16,
+  S32,
+  S64,
+  F32,
+  F64,
+};
+
+// [emubench] When a watch is read from guest memory
+enum class WatchTrigger : u8
+{
+  // Only when a client asks for the value (default)
+  OnDemand,
+  // At the end of every frame, in Step
+  EveryFrame,
+};
+
+// [emubench] Condition checked after every frame's read; an event is recorded when it becomes true
+enum class WatchPredicate : u8
+{
+  None,
+  // The value differs from the previous frame's
+  Change,
+  // value == operand
+  Equals,
+  // value > operand, compared as the watch's type (unsigned for byte watches)
+  GreaterThan,
+  // (value & mask) == operand
+  Mask,
+};
+
+std::optional<WatchType> ParseWatchType(std::string_view name);
+std::optional<WatchTrigger> ParseWatchTrigger(std::string_view name);
+std::optional<WatchPredicate> ParseWatchPredicate(std::string_view name);
+// Parses a watch's hex base address ("80123456" or "0x80123456")
+std::optional<u32> ParseWatchAddress(std::string_view address);
+u32 GetWatchTypeSize(WatchType type);
 
 // Represents a memory watch configuration that matches the TypeScript interface
 struct MemoryWatch
@@ -20,7 +81,33 @@ struct MemoryWatch
   std::string address;
   std::optional<std::vector<u32>> offsets;
   u32 size;
-  std::optional<std::string> current_value;
+  WatchType type = WatchType::Bytes;
+  WatchTrigger trigger = WatchTrigger::OnDemand;
+  // Watches with a predicate are always read every frame. Operand and mask hold the raw bits of
+  // the watch's type, so predicates other than Change need size <= 8.
+  WatchPredicate predicate = WatchPredicate::None;
+  u64 operand = 0;
+  u64 mask = ~u64{0};
+};
+
+// A watch's value as last read from guest memory. Bytes are in guest (big-endian) order.
+struct WatchValue
+{
+  WatchType type = WatchType::Bytes;
+  bool valid = false;
+  std::vector<u8> bytes;
+
+  std::string ToHex() const;
+};
+
+// [emubench] A predicate that fired: the frame it was seen on and the value that made it true
+struct WatchEvent
+{
+  // Increases by one per event, across all watches
+  u64 sequence = 0;
+  u64 frame = 0;
+  std::string name;
+  WatchValue value;
 };
 
 // This guy based off of `MemoryWatcher.cpp`
@@ -29,28 +116,91 @@ class MemWatcher final
 public:
   // Singleton pattern
   static MemWatcher& GetInstance();
-      
+
   // Delete copy constructor and assignment operator
   MemWatcher(const MemWatcher&) = delete;
   MemWatcher& operator=(const MemWatcher&) = delete;
   void Step(const Core::CPUThreadGuard& guard);
-  void WatchAddress(std::string name, const MemoryWatch& mw);
-  std::string ReadNBytesAsHex(const Core::CPUThreadGuard& guard, u32 address, u32 size);
+  // Registers or replaces a watch. Returns false, leaving the watches unchanged, if its address
+  // doesn't parse.
+  bool WatchAddress(std::string name, const MemoryWatch& mw);
+  // Reads the given on-demand watches from guest memory now, in one batch on the CPU thread.
+  // Returns false if the CPU thread didn't get to it in time; the values are then the last ones
+  // read. On the GPU thread, which can't wait for the CPU, only watches in directly mapped
+  // MEM1/MEM2 are refreshed and the rest (fake VMEM, translated addresses) keep their last value.
+  bool RefreshValues(const std::vector<std::string>& names);
   std::optional<std::string> FetchValue(const std::string& name);
-  
+  // Fetches several watches under one lock; missing names yield std::nullopt
+  std::vector<std::optional<WatchValue>> FetchValues(const std::vector<std::string>& names);
+
+  // Frame number stamped on events, normally the IPC server's frame counter
+  void SetFrameSource(std::function<u64()> frame_source);
+  // Called on the CPU thread at the end of every Step, after that frame's predicates were evaluated
+  void SetStepCallback(std::function<void(const Core::CPUThreadGuard&)> callback);
+  // Sequence number the next event will get
+  u64 GetNextEventSequence();
+  // Events with sequence >= `since`, optionally only for `names` (empty means all). Waits up to
+  // `timeout` for one to arrive if there are none yet.
+  std::vector<WatchEvent> GetEvents(u64 since, const std::vector<std::string>& names = {},
+                                    std::chrono::milliseconds timeout = {});
+
   // Get future that resolves when Step runs for the first time
   std::shared_future<void> GetFramesStartedFuture() { return m_frames_started.get_future().share(); }
-  
+
   void ResetFramesStarted();
 
 private:
   MemWatcher() = default;
 
+  void AppendWatch(const std::string& name, const MemoryWatch& mw, u32 address);
+  void Compile(std::string_view replaced);
   void UpdateValues(const Core::CPUThreadGuard& guard);
-  void UpdateValue(const Core::CPUThreadGuard& guard, MemoryWatch& mw);
-  std::string ChasePointer(const Core::CPUThreadGuard& guard, const MemoryWatch& mw);
+  void UpdateValue(const Core::CPUThreadGuard* guard, Memory::MemoryManager& memory, size_t index);
+  std::optional<u32> ResolveAddress(const Core::CPUThreadGuard* guard,
+                                    Memory::MemoryManager& memory, size_t index);
+  void EvaluatePredicates();
+  bool IsPredicateTrue(size_t index) const;
 
+  // Watch configurations as registered, by name
   std::map<std::string, MemoryWatch> m_memwatches;
+
+  // Watches compiled into flat arrays so a frame's reads are a tight loop of bulk copies.
+  // Everything below is indexed by the position of the watch in m_names.
+  std::vector<std::string> m_names;
+  std::map<std::string, size_t, std::less<>> m_indices;
+  std::vector<u32> m_addresses;
+  std::vector<u32> m_sizes;
+  std::vector<WatchType> m_types;
+  // Indices of the watches Step refreshes every frame
+  std::vector<size_t> m_every_frame;
+  // Pointer chain of watch i is m_offsets[m_offset_begin[i], m_offset_begin[i] + m_offset_count[i])
+  std::vector<u32> m_offset_begin;
+  std::vector<u32> m_offset_count;
+  std::vector<u32> m_offsets;
+  // Value of watch i is m_values[m_value_begin[i], m_value_begin[i] + m_sizes[i])
+  std::vector<u32> m_value_begin;
+  std::vector<u8> m_values;
+  std::vector<u8> m_valid;
+
+  // Watches with a predicate, and per watch the predicate and its last result (PredicateState)
+  std::vector<size_t> m_predicated;
+  std::vector<WatchPredicate> m_predicates;
+  std::vector<u64> m_operands;
+  std::vector<u64> m_masks;
+  std::vector<u8> m_predicate_states;
+  // Values as of the previous evaluation, laid out like m_values, for WatchPredicate::Change
+  std::vector<u8> m_previous_values;
+
+  // Most recent events, oldest first. Bounded; clients that fall behind lose the oldest ones.
+  static constexpr size_t MAX_EVENTS = 4096;
+  std::deque<WatchEvent> m_events;
+  u64 m_next_event_sequence = 0;
+  std::condition_variable m_event_cv;
+  std::function<u64()> m_frame_source;
+  std::function<void(const Core::CPUThreadGuard&)> m_step_callback;
+
+  // Guards the compiled arrays and values between the CPU thread and HTTP threads
+  std::mutex m_lock;
   std::promise<void> m_frames_started;
   bool m_step_called = false;
 };
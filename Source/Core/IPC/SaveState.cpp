@@ -1,5 +1,16 @@
 #include "IPC/SaveState.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include <lz4.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+
 namespace IPC
 {
 
@@ -40,4 +51,499 @@ void SaveState::LoadFromFile(const std::string& filepath)
   State::LoadAs(system, filepath);
 }
 
+// [emubench] Save the current state into the in-memory pool under `id`, replacing any
+// existing snapshot with that id
+bool SaveState::SaveToSnapshot(const std::string& id)
+{
+  Core::System& system = Core::System::GetInstance();
+  if (!Core::IsRunningOrStarting(system))
+    return false;
+
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  State::SaveToBuffer(system, m_scratch_buffer);
+  return StoreSnapshot(id, Snapshot{});
+}
+
+bool SaveState::SaveToDeltaSnapshot(const std::string& id, const std::string& base_id)
+{
+  Core::System& system = Core::System::GetInstance();
+  if (!Core::IsRunningOrStarting(system))
+    return false;
+
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  const Snapshot* base = nullptr;
+  if (!base_id.empty())
+  {
+    auto it = m_snapshots.find(base_id);
+    if (it == m_snapshots.end() || !it->second.IsDelta())
+    {
+      NOTICE_LOG_FMT(CORE, "IPC: Base snapshot {} does not exist or is not a delta snapshot",
+                     base_id);
+      return false;
+    }
+    base = &it->second;
+  }
+
+  Snapshot snapshot;
+  auto& memory = system.GetMemory();
+  Core::RunOnCPUThread(
+      system,
+      [&] {
+        memory.SetStateRegionHandler([&](PointerWrap& p) {
+          if (p.IsWriteMode())
+            snapshot.ram_pages = CapturePages(base);
+        });
+        State::SaveToBuffer(system, m_scratch_buffer);
+        memory.SetStateRegionHandler(nullptr);
+      },
+      true);
+
+  if (!snapshot.IsDelta())
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Failed to capture memory pages for snapshot {}", id);
+    return false;
+  }
+
+  return StoreSnapshot(id, std::move(snapshot));
+}
+
+// Moves the state in m_scratch_buffer into `snapshot` (compressing it if enabled) and adds it to
+// the pool. Must be called with m_snapshot_lock held.
+bool SaveState::StoreSnapshot(const std::string& id, Snapshot snapshot)
+{
+  if (m_scratch_buffer.empty())
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Failed to save snapshot {}", id);
+    return false;
+  }
+
+  snapshot.uncompressed_size = m_scratch_buffer.size();
+  snapshot.compressed = m_snapshot_compression && m_scratch_buffer.size() <= LZ4_MAX_INPUT_SIZE;
+
+  if (snapshot.compressed)
+  {
+    const int raw_size = static_cast<int>(m_scratch_buffer.size());
+    snapshot.data.resize(LZ4_compressBound(raw_size));
+    const int compressed_len = LZ4_compress_default(
+        reinterpret_cast<const char*>(m_scratch_buffer.data()),
+        reinterpret_cast<char*>(snapshot.data.data()), raw_size,
+        static_cast<int>(snapshot.data.size()));
+    if (compressed_len <= 0)
+    {
+      NOTICE_LOG_FMT(CORE, "IPC: LZ4 compression failed for snapshot {}", id);
+      return false;
+    }
+    snapshot.data.resize(compressed_len);
+    snapshot.data.shrink_to_fit();
+  }
+  else
+  {
+    // Hand the scratch buffer over to the pool; the next save will allocate a new one
+    snapshot.data = std::move(m_scratch_buffer);
+    m_scratch_buffer = {};
+  }
+
+  const u64 snapshot_size = snapshot.data.size();
+  if (!EvictSnapshotsFor(snapshot_size, id))
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} ({} bytes) does not fit in budget of {} bytes", id,
+                   snapshot_size, m_snapshot_budget);
+    return false;
+  }
+
+  auto it = m_snapshots.find(id);
+  if (it != m_snapshots.end())
+  {
+    m_snapshot_pool_size -= it->second.data.size();
+    it->second = std::move(snapshot);
+  }
+  else
+  {
+    it = m_snapshots.emplace(id, std::move(snapshot)).first;
+  }
+  m_snapshot_pool_size += snapshot_size;
+  TouchSnapshot(id);
+
+  NOTICE_LOG_FMT(CORE, "IPC: Saved snapshot {} ({} bytes, {} raw), pool size {} bytes", id,
+                 snapshot_size, it->second.uncompressed_size,
+                 m_snapshot_pool_size + m_snapshot_page_bytes);
+  return true;
+}
+
+// Pages report their own lifetime so the pool size stays correct however they are shared
+std::shared_ptr<SnapshotPage> SaveState::AllocateSnapshotPage()
+{
+  m_snapshot_page_bytes += SNAPSHOT_PAGE_SIZE;
+  return std::shared_ptr<SnapshotPage>(new SnapshotPage, [this](SnapshotPage* page) {
+    m_snapshot_page_bytes -= SNAPSHOT_PAGE_SIZE;
+    delete page;
+  });
+}
+
+// MEM1, fake VMEM and MEM2, in the order delta snapshots store their pages. Absent regions have
+// size 0.
+std::array<std::pair<u8*, u32>, 3> SaveState::GetGuestMemoryRegions()
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  return {{
+      {memory.GetRAM(), memory.GetRamSize()},
+      {memory.GetFakeVMEM(), memory.GetFakeVMEM() ? memory.GetFakeVMemSize() : 0},
+      {memory.GetEXRAM(), memory.GetEXRAM() ? memory.GetExRamSize() : 0},
+  }};
+}
+
+u32 SaveState::GetGuestPageCount()
+{
+  u32 count = 0;
+  for (const auto& [region, size] : GetGuestMemoryRegions())
+    count += (size + SNAPSHOT_PAGE_SIZE - 1) / SNAPSHOT_PAGE_SIZE;
+  return count;
+}
+
+// Splits MEM1, fake VMEM and MEM2 into pages, sharing every page that matches `base`. Runs on the
+// CPU thread from inside MemoryManager::DoState.
+std::vector<std::shared_ptr<const SnapshotPage>> SaveState::CapturePages(const Snapshot* base)
+{
+  const std::array<std::pair<u8*, u32>, 3> regions = GetGuestMemoryRegions();
+
+  std::vector<std::shared_ptr<const SnapshotPage>> pages;
+  u32 new_pages = 0;
+  for (const auto& [region, size] : regions)
+  {
+    for (u32 offset = 0; offset < size; offset += SNAPSHOT_PAGE_SIZE)
+    {
+      const u8* src = region + offset;
+      const size_t index = pages.size();
+      if (base && index < base->ram_pages.size() &&
+          std::memcmp(base->ram_pages[index]->data(), src, SNAPSHOT_PAGE_SIZE) == 0)
+      {
+        pages.push_back(base->ram_pages[index]);
+        continue;
+      }
+
+      auto page = AllocateSnapshotPage();
+      std::memcpy(page->data(), src, SNAPSHOT_PAGE_SIZE);
+      pages.push_back(std::move(page));
+      new_pages++;
+    }
+  }
+
+  NOTICE_LOG_FMT(CORE, "IPC: Captured {} pages, {} changed from base", pages.size(), new_pages);
+  return pages;
+}
+
+// Callers check that the snapshot has GetGuestPageCount() pages, so every page is overwritten
+void SaveState::RestorePages(const Snapshot& snapshot)
+{
+  const std::array<std::pair<u8*, u32>, 3> regions = GetGuestMemoryRegions();
+
+  size_t index = 0;
+  for (const auto& [region, size] : regions)
+  {
+    for (u32 offset = 0; offset < size && index < snapshot.ram_pages.size();
+         offset += SNAPSHOT_PAGE_SIZE)
+    {
+      std::memcpy(region + offset, snapshot.ram_pages[index++]->data(), SNAPSHOT_PAGE_SIZE);
+    }
+  }
+}
+
+bool SaveState::LoadFromSnapshot(const std::string& id)
+{
+  Core::System& system = Core::System::GetInstance();
+  if (!Core::IsRunningOrStarting(system))
+    return false;
+
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  auto it = m_snapshots.find(id);
+  if (it == m_snapshots.end())
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} does not exist", id);
+    return false;
+  }
+
+  Snapshot& snapshot = it->second;
+
+  // A delta snapshot must cover all of guest memory, or part of it would keep its current contents
+  if (snapshot.IsDelta() && snapshot.ram_pages.size() != GetGuestPageCount())
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} has {} pages, the running game has {}", id,
+                   snapshot.ram_pages.size(), GetGuestPageCount());
+    return false;
+  }
+
+  // PointerWrap only reads from the buffer, so an uncompressed snapshot can be used directly
+  std::vector<u8>* state_buffer = &snapshot.data;
+  if (snapshot.compressed)
+  {
+    m_scratch_buffer.resize(snapshot.uncompressed_size);
+    const int bytes_read = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(snapshot.data.data()),
+        reinterpret_cast<char*>(m_scratch_buffer.data()), static_cast<int>(snapshot.data.size()),
+        static_cast<int>(m_scratch_buffer.size()));
+    if (bytes_read < 0 || static_cast<u64>(bytes_read) != snapshot.uncompressed_size)
+    {
+      NOTICE_LOG_FMT(CORE, "IPC: LZ4 decompression failed for snapshot {}", id);
+      return false;
+    }
+    state_buffer = &m_scratch_buffer;
+  }
+
+  if (snapshot.IsDelta())
+  {
+    auto& memory = system.GetMemory();
+    Core::RunOnCPUThread(
+        system,
+        [&] {
+          memory.SetStateRegionHandler([&](PointerWrap& p) {
+            if (p.IsReadMode())
+              RestorePages(snapshot);
+          });
+          State::LoadFromBuffer(system, *state_buffer);
+          memory.SetStateRegionHandler(nullptr);
+        },
+        true);
+  }
+  else
+  {
+    State::LoadFromBuffer(system, *state_buffer);
+  }
+
+  TouchSnapshot(id);
+  return true;
+}
+
+bool SaveState::DeleteSnapshot(const std::string& id)
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  auto it = m_snapshots.find(id);
+  if (it == m_snapshots.end())
+    return false;
+
+  m_snapshot_pool_size -= it->second.data.size();
+  m_snapshots.erase(it);
+  m_snapshot_lru.remove(id);
+  return true;
+}
+
+void SaveState::ClearSnapshots()
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+  m_snapshots.clear();
+  m_snapshot_lru.clear();
+  m_snapshot_pool_size = 0;
+}
+
+std::vector<std::string> SaveState::GetSnapshotIds()
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+  std::vector<std::string> ids;
+  ids.reserve(m_snapshots.size());
+  for (const auto& [id, snapshot] : m_snapshots)
+    ids.push_back(id);
+  return ids;
+}
+
+std::optional<std::vector<u8>> SaveState::ExportSnapshot(const std::string& id)
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  auto it = m_snapshots.find(id);
+  if (it == m_snapshots.end())
+    return std::nullopt;
+
+  const Snapshot& snapshot = it->second;
+  SnapshotExportHeader header{};
+  header.magic = SNAPSHOT_EXPORT_MAGIC;
+  header.version = SNAPSHOT_EXPORT_VERSION;
+  header.uncompressed_size = snapshot.uncompressed_size;
+  header.data_size = snapshot.data.size();
+  header.page_count = static_cast<u32>(snapshot.ram_pages.size());
+  header.compressed = snapshot.compressed;
+  FillExportIdentity(&header);
+
+  std::vector<u8> bytes(sizeof(header) + snapshot.data.size() +
+                        snapshot.ram_pages.size() * SNAPSHOT_PAGE_SIZE);
+  u8* ptr = bytes.data();
+  std::memcpy(ptr, &header, sizeof(header));
+  ptr += sizeof(header);
+  std::memcpy(ptr, snapshot.data.data(), snapshot.data.size());
+  ptr += snapshot.data.size();
+  for (const auto& page : snapshot.ram_pages)
+  {
+    std::memcpy(ptr, page->data(), SNAPSHOT_PAGE_SIZE);
+    ptr += SNAPSHOT_PAGE_SIZE;
+  }
+
+  TouchSnapshot(id);
+  return bytes;
+}
+
+bool SaveState::ImportSnapshot(const std::string& id, std::string_view bytes)
+{
+  SnapshotExportHeader header;
+  if (bytes.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if (header.magic != SNAPSHOT_EXPORT_MAGIC || header.version != SNAPSHOT_EXPORT_VERSION)
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} has an unknown export format", id);
+    return false;
+  }
+
+  SnapshotExportHeader expected{};
+  FillExportIdentity(&expected);
+  if (header.ram_size != expected.ram_size || header.exram_size != expected.exram_size ||
+      std::memcmp(header.game_id, expected.game_id, sizeof(header.game_id)) != 0)
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} is from another game or memory layout", id);
+    return false;
+  }
+
+  // Checked term by term so a hostile size can't wrap the sum around
+  const u64 payload_size = bytes.size() - sizeof(header);
+  const u64 pages_size = u64{header.page_count} * SNAPSHOT_PAGE_SIZE;
+  if (header.data_size > payload_size || pages_size > payload_size ||
+      header.data_size + pages_size != payload_size)
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} export is truncated ({} bytes)", id, bytes.size());
+    return false;
+  }
+
+  // Loading decompresses into a buffer of this size
+  const bool size_valid = header.compressed ?
+                              header.uncompressed_size <= SNAPSHOT_MAX_STATE_SIZE :
+                              header.uncompressed_size == header.data_size;
+  if (!size_valid || header.data_size == 0 || header.uncompressed_size == 0 ||
+      header.data_size > SNAPSHOT_MAX_STATE_SIZE)
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} has an invalid state size", id);
+    return false;
+  }
+
+  // Delta snapshots have to cover all of this instance's guest memory
+  if (header.page_count != 0 && header.page_count != GetGuestPageCount())
+  {
+    NOTICE_LOG_FMT(CORE, "IPC: Snapshot {} has {} pages, the running game has {}", id,
+                   header.page_count, GetGuestPageCount());
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+
+  Snapshot snapshot;
+  snapshot.uncompressed_size = header.uncompressed_size;
+  snapshot.compressed = header.compressed != 0;
+
+  const u8* ptr = reinterpret_cast<const u8*>(bytes.data()) + sizeof(header);
+  snapshot.data.assign(ptr, ptr + header.data_size);
+  ptr += header.data_size;
+
+  snapshot.ram_pages.reserve(header.page_count);
+  for (u32 i = 0; i < header.page_count; i++)
+  {
+    auto page = AllocateSnapshotPage();
+    std::memcpy(page->data(), ptr, SNAPSHOT_PAGE_SIZE);
+    ptr += SNAPSHOT_PAGE_SIZE;
+    snapshot.ram_pages.push_back(std::move(page));
+  }
+
+  const u64 snapshot_size = snapshot.data.size();
+  if (!EvictSnapshotsFor(snapshot_size, id))
+    return false;
+
+  auto it = m_snapshots.find(id);
+  if (it != m_snapshots.end())
+    m_snapshot_pool_size -= it->second.data.size();
+  m_snapshots[id] = std::move(snapshot);
+  m_snapshot_pool_size += snapshot_size;
+  TouchSnapshot(id);
+  return true;
+}
+
+void SaveState::SetSnapshotCompression(bool compression)
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+  m_snapshot_compression = compression;
+}
+
+void SaveState::SetSnapshotBudget(u64 budget_bytes)
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+  m_snapshot_budget = budget_bytes;
+  EvictSnapshotsFor(0, "");
+}
+
+u64 SaveState::GetSnapshotPoolSize()
+{
+  std::lock_guard<std::mutex> lk(m_snapshot_lock);
+  return m_snapshot_pool_size + m_snapshot_page_bytes;
+}
+
+void SaveState::FillExportIdentity(SnapshotExportHeader* header)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  header->ram_size = memory.GetRamSize();
+  header->exram_size = memory.GetEXRAM() ? memory.GetExRamSize() : 0;
+
+  const std::string game_id = SConfig::GetInstance().GetGameID();
+  std::memset(header->game_id, 0, sizeof(header->game_id));
+  std::memcpy(header->game_id, game_id.data(), std::min(game_id.size(), sizeof(header->game_id)));
+}
+
+void SaveState::TouchSnapshot(const std::string& id)
+{
+  m_snapshot_lru.remove(id);
+  m_snapshot_lru.push_front(id);
+}
+
+u64 SaveState::GetReleasableSize(const Snapshot& snapshot)
+{
+  const auto unshared = std::ranges::count_if(
+      snapshot.ram_pages, [](const auto& page) { return page.use_count() == 1; });
+  return snapshot.data.size() + static_cast<u64>(unshared) * SNAPSHOT_PAGE_SIZE;
+}
+
+// Evicts least recently used snapshots until `needed_bytes` more fit in the budget. The snapshot
+// named `keep_id` is about to be replaced, so what it would give back doesn't count against the
+// budget.
+bool SaveState::EvictSnapshotsFor(u64 needed_bytes, const std::string& keep_id)
+{
+  if (needed_bytes > m_snapshot_budget)
+    return false;
+
+  // Evicting a snapshot can leave pages held only by the kept one, so this is worked out anew
+  const auto fits = [&] {
+    const auto kept = m_snapshots.find(keep_id);
+    const u64 kept_size = kept != m_snapshots.end() ? GetReleasableSize(kept->second) : 0;
+    return m_snapshot_pool_size + m_snapshot_page_bytes - kept_size + needed_bytes <=
+           m_snapshot_budget;
+  };
+
+  auto it = m_snapshot_lru.end();
+  while (!fits() && it != m_snapshot_lru.begin())
+  {
+    --it;
+    if (*it == keep_id)
+      continue;
+
+    auto evicted = m_snapshots.find(*it);
+    const u64 released = GetReleasableSize(evicted->second);
+    NOTICE_LOG_FMT(CORE, "IPC: Evicting snapshot {} to stay within budget, releasing {} bytes", *it,
+                   released);
+    // The state buffer is counted here; pages nothing else holds take their bytes off
+    // m_snapshot_page_bytes as the erase frees them
+    m_snapshot_pool_size -= evicted->second.data.size();
+    m_snapshots.erase(evicted);
+    it = m_snapshot_lru.erase(it);
+  }
+
+  return fits();
+}
+
 } // namespace IPC
@@ -1,16 +1,73 @@
+#pragma once
+
+#include "Common/CommonTypes.h"
 #include "Core/State.h"
 #include "Core/System.h"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace IPC
 {
 
+// [emubench] Guest memory is split into pages of this size for delta snapshots
+constexpr u32 SNAPSHOT_PAGE_SIZE = 0x1000;
+using SnapshotPage = std::array<u8, SNAPSHOT_PAGE_SIZE>;
+
+// [emubench] A save state kept in RAM, keyed by a client-chosen id
+struct Snapshot
+{
+  std::vector<u8> data;
+  u64 uncompressed_size = 0;
+  bool compressed = false;
+  // Delta snapshots keep MEM1/fake VMEM/MEM2 out of `data` and hold them here instead. Pages that
+  // are unchanged from the base snapshot are shared with it rather than copied.
+  std::vector<std::shared_ptr<const SnapshotPage>> ram_pages;
+
+  bool IsDelta() const { return !ram_pages.empty(); }
+};
+
+// [emubench] Layout of an exported snapshot: this header, `data_size` bytes of state, then
+// `page_count` pages of guest memory for delta snapshots. A snapshot is only imported by an
+// instance running the same game with the same memory sizes.
+struct SnapshotExportHeader
+{
+  u32 magic;
+  u32 version;
+  u64 uncompressed_size;
+  u64 data_size;
+  u32 page_count;
+  u32 ram_size;
+  u32 exram_size;
+  u8 compressed;
+  u8 padding[3];
+  // Zero-padded, as returned by SConfig::GetGameID
+  char game_id[16];
+};
+static_assert(sizeof(SnapshotExportHeader) == 56);
+static_assert(std::is_trivially_copyable_v<SnapshotExportHeader>);
+
+constexpr u32 SNAPSHOT_EXPORT_MAGIC = 0x53534245;  // "EBSS"
+constexpr u32 SNAPSHOT_EXPORT_VERSION = 2;
+// Far above any real save state, including Wii ones with MEM2 and fake VMEM in them
+constexpr u64 SNAPSHOT_MAX_STATE_SIZE = 512ULL * 1024 * 1024;
+
 class SaveState final
 {
 public:
   // Singleton pattern
   static SaveState& GetInstance();
-  
+
   // Delete copy constructor and assignment operator
   SaveState(const SaveState&) = delete;
   SaveState& operator=(const SaveState&) = delete;
@@ -21,8 +78,58 @@ public:
   void SaveToFile(const std::string& filepath, bool wait_for_completion = false);
   void LoadFromFile(const std::string& filepath);
 
+  // [emubench] In-memory snapshot pool. Saving and loading go through State::SaveToBuffer and
+  // State::LoadFromBuffer, so no file is written, read or (optionally) compressed.
+  bool SaveToSnapshot(const std::string& id);
+  // Saves a snapshot whose guest memory is stored as pages. With a `base_id`, only the pages that
+  // differ from that (delta) snapshot take new memory; without one, this starts a new root.
+  bool SaveToDeltaSnapshot(const std::string& id, const std::string& base_id = "");
+  bool LoadFromSnapshot(const std::string& id);
+  bool DeleteSnapshot(const std::string& id);
+  void ClearSnapshots();
+  std::vector<std::string> GetSnapshotIds();
+
+  // Serializes a snapshot so another emulator instance running the same game can import it. Lets
+  // already-booted workers pick up a branch state without touching disk. (Cloning the process
+  // with fork() isn't an option: only the calling thread survives it, and the clone would share
+  // the parent's GPU context and sockets.)
+  std::optional<std::vector<u8>> ExportSnapshot(const std::string& id);
+  bool ImportSnapshot(const std::string& id, std::string_view bytes);
+
+  // Snapshots saved after this call are stored LZ4-compressed (default) or raw.
+  void SetSnapshotCompression(bool compression);
+  // Total bytes the pool may hold. Least recently used snapshots are evicted to make room.
+  void SetSnapshotBudget(u64 budget_bytes);
+  u64 GetSnapshotPoolSize();
+
 private:
   SaveState() = default;
+
+  bool StoreSnapshot(const std::string& id, Snapshot snapshot);
+  std::shared_ptr<SnapshotPage> AllocateSnapshotPage();
+  static std::array<std::pair<u8*, u32>, 3> GetGuestMemoryRegions();
+  // Pages a delta snapshot of the running game holds
+  static u32 GetGuestPageCount();
+  std::vector<std::shared_ptr<const SnapshotPage>> CapturePages(const Snapshot* base);
+  void RestorePages(const Snapshot& snapshot);
+  void TouchSnapshot(const std::string& id);
+  // Fills in the fields identifying the running game and its memory layout
+  static void FillExportIdentity(SnapshotExportHeader* header);
+  bool EvictSnapshotsFor(u64 needed_bytes, const std::string& keep_id);
+  // Bytes removing `snapshot` would give back: its state buffer and the pages only it holds
+  static u64 GetReleasableSize(const Snapshot& snapshot);
+
+  std::mutex m_snapshot_lock;
+  std::map<std::string, Snapshot> m_snapshots;
+  // Most recently used at the front
+  std::list<std::string> m_snapshot_lru;
+  // Bytes held by snapshot state buffers; delta pages are counted separately since they are shared
+  u64 m_snapshot_pool_size = 0;
+  std::atomic<u64> m_snapshot_page_bytes = 0;
+  u64 m_snapshot_budget = 1024ULL * 1024 * 1024;
+  bool m_snapshot_compression = true;
+  // Reused between saves/loads so resets don't reallocate a state-sized buffer every time
+  std::vector<u8> m_scratch_buffer;
 };
 
 } // namespace IPC
@@ -0,0 +1,161 @@
+#include "IPC/ScreenshotStore.h"
+
+#include <cstring>
+
+#include "Common/Image.h"
+#include "VideoCommon/FrameDumper.h"
+
+namespace IPC
+{
+
+std::optional<ScreenshotMode> ParseScreenshotMode(std::string_view name)
+{
+  if (name == "file")
+    return ScreenshotMode::File;
+  if (name == "memory")
+    return ScreenshotMode::Memory;
+  return std::nullopt;
+}
+
+std::optional<ScreenshotEncoding> ParseScreenshotEncoding(std::string_view name)
+{
+  if (name == "png")
+    return ScreenshotEncoding::PNG;
+  if (name == "qoi")
+    return ScreenshotEncoding::QOI;
+  if (name == "rgba")
+    return ScreenshotEncoding::RGBA;
+  return std::nullopt;
+}
+
+const char* GetScreenshotContentType(ScreenshotEncoding encoding)
+{
+  switch (encoding)
+  {
+  case ScreenshotEncoding::QOI:
+    return "image/qoi";
+  case ScreenshotEncoding::RGBA:
+    return "application/octet-stream";
+  default:
+    return "image/png";
+  }
+}
+
+const char* GetScreenshotExtension(ScreenshotEncoding encoding)
+{
+  switch (encoding)
+  {
+  case ScreenshotEncoding::QOI:
+    return ".qoi";
+  case ScreenshotEncoding::RGBA:
+    return ".rgba";
+  default:
+    return ".png";
+  }
+}
+
+ScreenshotStore& ScreenshotStore::GetInstance() {
+  static ScreenshotStore instance;
+  return instance;
+}
+
+void ScreenshotStore::SetMode(ScreenshotMode mode)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_mode = mode;
+}
+
+ScreenshotMode ScreenshotStore::GetMode()
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  return m_mode;
+}
+
+void ScreenshotStore::SetEncoding(ScreenshotEncoding encoding)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_encoding = encoding;
+}
+
+ScreenshotEncoding ScreenshotStore::GetEncoding()
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  return m_encoding;
+}
+
+std::shared_ptr<CapturedFrame> ScreenshotStore::Allocate(const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  if (m_frames.find(name) == m_frames.end())
+  {
+    m_order.push_back(name);
+  }
+  while (m_order.size() > MAX_SCREENSHOTS)
+  {
+    m_frames.erase(m_order.front());
+    m_order.pop_front();
+  }
+
+  // The dump thread fills the frame after this returns; Get doesn't hand it out until it is done
+  auto frame = std::make_shared<CapturedFrame>();
+  m_frames[name] = frame;
+  return frame;
+}
+
+std::shared_ptr<const CapturedFrame> ScreenshotStore::Get(const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  auto it = m_frames.find(name);
+  if (it == m_frames.end() || !it->second->complete.IsSet())
+    return nullptr;
+  return it->second;
+}
+
+// Stacked frames are encoded as one image, each layer below the previous one
+std::optional<std::vector<u8>> ScreenshotStore::Encode(const CapturedFrame& frame,
+                                                       ScreenshotEncoding encoding)
+{
+  if (!frame.complete.IsSet() || frame.pixels.empty())
+    return std::nullopt;
+
+  const u32 height = frame.height * frame.layers;
+  std::vector<u8> encoded;
+  switch (encoding)
+  {
+  case ScreenshotEncoding::RGBA:
+    return frame.pixels;
+  case ScreenshotEncoding::QOI:
+    if (frame.channels == 1)
+    {
+      // QOI has no single channel format
+      std::vector<u8> rgba(frame.pixels.size() * 4);
+      for (size_t i = 0; i < frame.pixels.size(); i++)
+      {
+        std::memset(&rgba[i * 4], frame.pixels[i], 3);
+        rgba[i * 4 + 3] = 0xff;
+      }
+      Common::EncodeQOI(&encoded, rgba.data(), frame.width, height, frame.width * 4);
+      return encoded;
+    }
+    Common::EncodeQOI(&encoded, frame.pixels.data(), frame.width, height, frame.width * 4);
+    return encoded;
+  default:
+    if (frame.channels == 1)
+    {
+      if (!Common::EncodePNG(&encoded, frame.pixels.data(), Common::ImageByteFormat::Gray,
+                             frame.width, height, frame.width, PNG_COMPRESSION_LEVEL))
+      {
+        return std::nullopt;
+      }
+      return encoded;
+    }
+    if (!Common::ConvertRGBAToRGBAndEncodePNG(&encoded, frame.pixels.data(), frame.width, height,
+                                              frame.width * 4, PNG_COMPRESSION_LEVEL))
+    {
+      return std::nullopt;
+    }
+    return encoded;
+  }
+}
+
+} // namespace IPC
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct CapturedFrame;
+
+namespace IPC
+{
+
+// [emubench] Where screenshots go: PNG files in D_SCREENSHOTS_IDX (default) or kept in memory
+enum class ScreenshotMode : u8
+{
+  File,
+  Memory,
+};
+
+// [emubench] How in-memory screenshots are encoded when served or uploaded
+enum class ScreenshotEncoding : u8
+{
+  // Low-compression PNG
+  PNG,
+  QOI,
+  // Raw rows, top row first: RGBA8 (alpha is whatever the backend left there) or 8-bit luma for
+  // grayscale observations
+  RGBA,
+};
+
+std::optional<ScreenshotMode> ParseScreenshotMode(std::string_view name);
+std::optional<ScreenshotEncoding> ParseScreenshotEncoding(std::string_view name);
+const char* GetScreenshotContentType(ScreenshotEncoding encoding);
+const char* GetScreenshotExtension(ScreenshotEncoding encoding);
+
+// Keeps the most recent in-memory screenshots by name so they can be served without touching disk
+class ScreenshotStore final
+{
+public:
+  // Singleton pattern
+  static ScreenshotStore& GetInstance();
+
+  // Delete copy constructor and assignment operator
+  ScreenshotStore(const ScreenshotStore&) = delete;
+  ScreenshotStore& operator=(const ScreenshotStore&) = delete;
+
+  void SetMode(ScreenshotMode mode);
+  ScreenshotMode GetMode();
+  void SetEncoding(ScreenshotEncoding encoding);
+  ScreenshotEncoding GetEncoding();
+
+  // Returns the frame the dumper should fill for screenshot `name`, evicting the oldest if full
+  std::shared_ptr<CapturedFrame> Allocate(const std::string& name);
+  // Returns nullptr until the dump thread has finished filling the frame
+  std::shared_ptr<const CapturedFrame> Get(const std::string& name);
+
+  static std::optional<std::vector<u8>> Encode(const CapturedFrame& frame,
+                                               ScreenshotEncoding encoding);
+
+private:
+  ScreenshotStore() = default;
+
+  static constexpr size_t MAX_SCREENSHOTS = 64;
+  // Level 1 keeps most of the size win of the default level at a fraction of the encode time
+  static constexpr int PNG_COMPRESSION_LEVEL = 1;
+
+  std::mutex m_lock;
+  ScreenshotMode m_mode = ScreenshotMode::File;
+  ScreenshotEncoding m_encoding = ScreenshotEncoding::PNG;
+  std::map<std::string, std::shared_ptr<CapturedFrame>> m_frames;
+  // Oldest first
+  std::list<std::string> m_order;
+};
+
+} // namespace IPC
@@ -10,6 +10,7 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -18,6 +19,13 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
                            const OutputVertexData* v2);
 
 void SetTevKonstColors();
+// [emubench] Picks the TEV program for the current bpmem, once per batch
+void SetTevProgram();
+
+// [emubench] Finishes the triangles binned so far and publishes the pixel statistics and bounding
+// box. Must run before the EFB, the perf counters or the bounding box are read, and before the
+// state the triangles were set up with changes; SWVertexLoader does so after every batch.
+void Flush();
 
 struct RasterBlockPixel
 {
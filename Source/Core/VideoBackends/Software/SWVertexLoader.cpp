@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Software/SWVertexLoader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 
@@ -67,22 +68,16 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
 
   m_setup_unit.Init(primitive_type);
   Rasterizer::SetTevKonstColors();
+  Rasterizer::SetTevProgram();
+
+  TransformVertices();
 
   for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
   {
     const u16 index = m_cpu_index_buffer[i];
-    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
-
-    // parse the videocommon format to our own struct format (m_vertex)
-    SetFormat();
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
 
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_setup_unit.GetVertex();
-    TransformUnit::TransformPosition(&m_vertex, outVertex);
-    TransformUnit::TransformNormal(&m_vertex, outVertex);
-    TransformUnit::TransformColor(&m_vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_vertex, outVertex);
+    // [emubench] Vertices shared between primitives are only transformed once
+    *m_setup_unit.GetVertex() = m_transformed[m_vertex_slots[index]];
 
     // assemble and rasterize the primitive
     m_setup_unit.SetupVertex();
@@ -90,9 +85,45 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded);
   }
 
+  // [emubench] Rasterizer threads read bpmem and the shader constants, which may change after this
+  Rasterizer::Flush();
+
   INCSTAT(g_stats.this_frame.num_drawn_objects);
 }
 
+void SWVertexLoader::TransformVertices()
+{
+  static constexpr u32 NO_SLOT = std::numeric_limits<u32>::max();
+
+  const u32 num_indices = m_index_generator.GetIndexLen();
+  u16 max_index = 0;
+  for (u32 i = 0; i < num_indices; i++)
+    max_index = std::max(max_index, m_cpu_index_buffer[i]);
+  m_vertex_slots.assign(num_indices != 0 ? max_index + 1 : 0, NO_SLOT);
+
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  m_batch.Clear();
+  for (u32 i = 0; i < num_indices; i++)
+  {
+    const u16 index = m_cpu_index_buffer[i];
+    if (m_vertex_slots[index] != NO_SLOT)
+      continue;
+    m_vertex_slots[index] = static_cast<u32>(m_batch.vertices.size());
+
+    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
+
+    // parse the videocommon format to our own struct format (m_vertex)
+    SetFormat();
+    ParseVertex(vdec, index);
+    m_batch.Add(m_vertex);
+  }
+
+  // transform the vertices so that they can be used for rasterization
+  m_transformed.assign(m_batch.vertices.size(), OutputVertexData{});
+  TransformUnit::TransformBatch(m_batch, m_transformed.data());
+}
+
 void SWVertexLoader::SetFormat()
 {
   m_vertex.posMtx = xfmem.MatrixIndexA.PosNormalMtxIdx;
@@ -10,6 +10,7 @@
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/SetupUnit.h"
+#include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/VertexManagerBase.h"
 
@@ -27,7 +28,14 @@ protected:
 
   void SetFormat();
   void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  // [emubench] Parses and transforms every vertex the current batch references, once each
+  void TransformVertices();
 
   InputVertexData m_vertex{};
   SetupUnit m_setup_unit;
+
+  TransformUnit::InputVertexBatch m_batch;
+  std::vector<OutputVertexData> m_transformed;
+  // Index into m_transformed for each vertex buffer index
+  std::vector<u32> m_vertex_slots;
 };
@@ -107,6 +107,7 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
 
 void VideoSoftware::Shutdown()
 {
+  Rasterizer::Shutdown();
   ShutdownShared();
 }
 }  // namespace SW
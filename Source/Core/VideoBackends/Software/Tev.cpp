@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <unordered_map>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -31,28 +32,18 @@ static inline s16 Clamp1024(s16 in)
   return std::clamp<s16>(in, -1024, 1023);
 }
 
-void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
+void Tev::SetRasColor(const Stage& stage)
 {
-  switch (colorChan)
+  switch (stage.ras_channel)
   {
   case RasColorChan::Color0:
-  {
-    const u8* color = Color[0];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
-    RasColor.r = color[u32(swap[ColorChannel::Red])];
-    RasColor.g = color[u32(swap[ColorChannel::Green])];
-    RasColor.b = color[u32(swap[ColorChannel::Blue])];
-    RasColor.a = color[u32(swap[ColorChannel::Alpha])];
-  }
-  break;
   case RasColorChan::Color1:
   {
-    const u8* color = Color[1];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
-    RasColor.r = color[u32(swap[ColorChannel::Red])];
-    RasColor.g = color[u32(swap[ColorChannel::Green])];
-    RasColor.b = color[u32(swap[ColorChannel::Blue])];
-    RasColor.a = color[u32(swap[ColorChannel::Alpha])];
+    const u8* color = Color[stage.ras_channel == RasColorChan::Color1];
+    RasColor.r = color[stage.ras_swap[u32(ColorChannel::Red)]];
+    RasColor.g = color[stage.ras_swap[u32(ColorChannel::Green)]];
+    RasColor.b = color[stage.ras_swap[u32(ColorChannel::Blue)]];
+    RasColor.a = color[stage.ras_swap[u32(ColorChannel::Alpha)]];
   }
   break;
   case RasColorChan::AlphaBump:
@@ -68,16 +59,15 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   break;
   default:
   {
-    if (colorChan != RasColorChan::Zero)
-      PanicAlertFmt("Invalid ras color channel: {}", colorChan);
-
+    // Invalid channels were reported when the program was built
     RasColor = TevColor::All(0);
   }
   break;
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
+template <TevOp op, TevScale scale, bool clamp>
+void Tev::DrawColorRegular(const Stage& stage, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
   {
@@ -86,108 +76,127 @@ void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const Inpu
     const u16 c = InputReg.c + (InputReg.c >> 7);
 
     s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= s_ScaleLShiftLUT[cc.scale];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+    temp <<= s_ScaleLShiftLUT[scale];
+    temp += (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
     temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
+    temp = op == TevOp::Sub ? -temp : temp;
 
-    s32 result = ((InputReg.d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
-    result = result >> s_ScaleRShiftLUT[cc.scale];
+    s32 result = ((InputReg.d + stage.color_bias) << s_ScaleLShiftLUT[scale]) + temp;
+    result = result >> s_ScaleRShiftLUT[scale];
 
-    Reg[cc.dest][i] = result;
+    const s16 value = result;
+    Reg[stage.color_dest][i] = clamp ? Clamp255(value) : Clamp1024(value);
   }
 }
 
-void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
+template <TevComparison comparison, TevCompareMode mode, bool clamp>
+void Tev::DrawColorCompare(const Stage& stage, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
   {
     u32 a, b;
-    switch (cc.compare_mode)
+    if constexpr (mode == TevCompareMode::R8)
     {
-    case TevCompareMode::R8:
       a = inputs[RED_C].a;
       b = inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::GR16:
+    }
+    else if constexpr (mode == TevCompareMode::GR16)
+    {
       a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
       b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::BGR24:
+    }
+    else if constexpr (mode == TevCompareMode::BGR24)
+    {
       a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
       b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::RGB8:
+    }
+    else
+    {
       a = inputs[i].a;
       b = inputs[i].b;
-      break;
-
-    default:
-      PanicAlertFmt("Invalid compare mode {}", cc.compare_mode);
-      continue;
     }
 
-    if (cc.comparison == TevComparison::GT)
-      Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
+    s16 value;
+    if constexpr (comparison == TevComparison::GT)
+      value = inputs[i].d + ((a > b) ? inputs[i].c : 0);
     else
-      Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+      value = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+    Reg[stage.color_dest][i] = clamp ? Clamp255(value) : Clamp1024(value);
   }
 }
 
-void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
+template <TevOp op, TevScale scale, bool clamp>
+void Tev::DrawAlphaRegular(const Stage& stage, const InputRegType inputs[4])
 {
   const InputRegType& InputReg = inputs[ALP_C];
 
   const u16 c = InputReg.c + (InputReg.c >> 7);
 
   s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= s_ScaleLShiftLUT[ac.scale];
-  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
-  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+  temp <<= s_ScaleLShiftLUT[scale];
+  temp += (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+  temp = op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
 
-  s32 result = ((InputReg.d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
-  result = result >> s_ScaleRShiftLUT[ac.scale];
+  s32 result = ((InputReg.d + stage.alpha_bias) << s_ScaleLShiftLUT[scale]) + temp;
+  result = result >> s_ScaleRShiftLUT[scale];
 
-  Reg[ac.dest].a = result;
+  const s16 value = result;
+  Reg[stage.alpha_dest].a = clamp ? Clamp255(value) : Clamp1024(value);
 }
 
-void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
+template <TevComparison comparison, TevCompareMode mode, bool clamp>
+void Tev::DrawAlphaCompare(const Stage& stage, const InputRegType inputs[4])
 {
   u32 a, b;
-  switch (ac.compare_mode)
+  if constexpr (mode == TevCompareMode::R8)
   {
-  case TevCompareMode::R8:
     a = inputs[RED_C].a;
     b = inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::GR16:
+  }
+  else if constexpr (mode == TevCompareMode::GR16)
+  {
     a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
     b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::BGR24:
+  }
+  else if constexpr (mode == TevCompareMode::BGR24)
+  {
     a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
     b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::A8:
+  }
+  else
+  {
     a = inputs[ALP_C].a;
     b = inputs[ALP_C].b;
-    break;
-
-  default:
-    PanicAlertFmt("Invalid compare mode {}", ac.compare_mode);
-    return;
   }
 
-  if (ac.comparison == TevComparison::GT)
-    Reg[ac.dest].a = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
+  s16 value;
+  if constexpr (comparison == TevComparison::GT)
+    value = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
   else
-    Reg[ac.dest].a = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+    value = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+  Reg[stage.alpha_dest].a = clamp ? Clamp255(value) : Clamp1024(value);
+}
+
+template <size_t... I>
+constexpr std::array<Tev::CombinerFunc, sizeof...(I)>
+Tev::MakeColorCombiners(std::index_sequence<I...>)
+{
+  return {((I & 3) == u32(TevBias::Compare) ?
+               &Tev::DrawColorCompare<TevComparison((I >> 2) & 1), TevCompareMode(I >> 4),
+                                      ((I >> 3) & 1) != 0> :
+               &Tev::DrawColorRegular<TevOp((I >> 2) & 1), TevScale(I >> 4),
+                                      ((I >> 3) & 1) != 0>)...};
+}
+
+template <size_t... I>
+constexpr std::array<Tev::CombinerFunc, sizeof...(I)>
+Tev::MakeAlphaCombiners(std::index_sequence<I...>)
+{
+  return {((I & 3) == u32(TevBias::Compare) ?
+               &Tev::DrawAlphaCompare<TevComparison((I >> 2) & 1), TevCompareMode(I >> 4),
+                                      ((I >> 3) & 1) != 0> :
+               &Tev::DrawAlphaRegular<TevOp((I >> 2) & 1), TevScale(I >> 4),
+                                      ((I >> 3) & 1) != 0>)...};
 }
 
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
@@ -384,79 +393,179 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+Tev::ProgramUID::ProgramUID()
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+  size_t i = 0;
+  words[i++] = bpmem.genMode.hex;
+  words[i++] = bpmem.tevindref.hex;
+  for (const TEXSCALE& texscale : bpmem.texscale)
+    words[i++] = texscale.hex;
+  for (const TwoTevStageOrders& order : bpmem.tevorders)
+    words[i++] = order.hex;
+  for (const TevStageCombiner& combiner : bpmem.combiners)
+  {
+    words[i++] = combiner.colorC.hex;
+    words[i++] = combiner.alphaC.hex;
+  }
+  for (const TevKSel& ksel : bpmem.tevksel.ksel)
+    words[i++] = ksel.hex;
+  for (const TevStageIndirect& indirect : bpmem.tevind)
+    words[i++] = indirect.hex;
+  words[i++] = bpmem.alpha_test.hex;
+  words[i++] = bpmem.zmode.hex;
+  words[i++] = bpmem.zcontrol.hex;
+  ASSERT(i == words.size());
+
+  hash = SIZE_MAX;
+  for (u32 word : words)
+    hash = hash * 137 + word;
+}
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+static std::unordered_map<Tev::ProgramUID, Tev::Program> s_programs;
 
-  auto& system = Core::System::GetInstance();
-  auto& pixel_shader_manager = system.GetPixelShaderManager();
+const Tev::Program& Tev::GetProgram()
+{
+  const auto [iter, inserted] = s_programs.try_emplace(ProgramUID());
+  Program& program = iter->second;
+  if (!inserted)
+    return program;
 
-  // initial color values
-  for (int i = 0; i < 4; i++)
-  {
-    Reg[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
-    Reg[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
-    Reg[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
-    Reg[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
-  }
+  static constexpr auto color_combiners = MakeColorCombiners(std::make_index_sequence<64>());
+  static constexpr auto alpha_combiners = MakeAlphaCombiners(std::make_index_sequence<64>());
 
-  for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
+  program.num_indirect_stages = bpmem.genMode.numindstages;
+  for (u32 stageNum = 0; stageNum < program.num_indirect_stages; stageNum++)
   {
     const int stageNum2 = stageNum >> 1;
     const int stageOdd = stageNum & 1;
-
-    u32 texcoordSel = bpmem.tevindref.getTexCoord(stageNum);
-    const u32 texmap = bpmem.tevindref.getTexMap(stageNum);
+    IndirectStage& stage = program.indirect_stages[stageNum];
 
     // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
     // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
     // This affects the Mario portrait in Luigi's Mansion, where the developers forgot to set
     // the number of tex gens to 2 (bug 11462).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
+    const u32 texcoordSel = bpmem.tevindref.getTexCoord(stageNum);
+    stage.texcoord = texcoordSel < bpmem.genMode.numtexgens ? texcoordSel : 0;
+    stage.texmap = bpmem.tevindref.getTexMap(stageNum);
 
     const TEXSCALE& texscale = bpmem.texscale[stageNum2];
-    const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
-    const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
-
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+    stage.scale_s = stageOdd ? texscale.ss1 : texscale.ss0;
+    stage.scale_t = stageOdd ? texscale.ts1 : texscale.ts0;
   }
 
-  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+  program.num_stages = bpmem.genMode.numtevstages + 1;
+  for (u32 stageNum = 0; stageNum < program.num_stages; stageNum++)
   {
     const int stageNum2 = stageNum >> 1;
     const int stageOdd = stageNum & 1;
     const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
-
-    // stage combiners
     const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
     const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
+    Stage& stage = program.stages[stageNum];
+
+    // Same quirk as for the indirect stages
+    const u32 texcoordSel = order.getTexCoord(stageOdd);
+    stage.texcoord = texcoordSel < bpmem.genMode.numtexgens ? texcoordSel : 0;
+    stage.texmap = order.getTexMap(stageOdd);
+    stage.direct_texcoord = bpmem.tevind[stageNum].hex == 0;
+    stage.texture_enabled = order.getEnable(stageOdd);
+    stage.sample_texture = stage.texture_enabled && bpmem.genMode.numtexgens > 0;
+
+    const auto tex_swap = bpmem.tevksel.GetSwapTable(ac.tswap);
+    const auto ras_swap = bpmem.tevksel.GetSwapTable(ac.rswap);
+    for (ColorChannel channel : {ColorChannel::Red, ColorChannel::Green, ColorChannel::Blue,
+                                 ColorChannel::Alpha})
+    {
+      stage.tex_swap[u32(channel)] = u8(tex_swap[channel]);
+      stage.ras_swap[u32(channel)] = u8(ras_swap[channel]);
+    }
 
-    u32 texcoordSel = order.getTexCoord(stageOdd);
-    const u32 texmap = order.getTexMap(stageOdd);
+    stage.ras_channel = order.getColorChan(stageOdd);
+    if (stage.ras_channel != RasColorChan::Color0 && stage.ras_channel != RasColorChan::Color1 &&
+        stage.ras_channel != RasColorChan::AlphaBump &&
+        stage.ras_channel != RasColorChan::NormalizedAlphaBump &&
+        stage.ras_channel != RasColorChan::Zero)
+    {
+      PanicAlertFmt("Invalid ras color channel: {}", stage.ras_channel);
+    }
 
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
+    stage.konst_color = bpmem.tevksel.GetKonstColor(stageNum);
+    stage.konst_alpha = bpmem.tevksel.GetKonstAlpha(stageNum);
+
+    stage.color_args = {cc.a, cc.b, cc.c, cc.d};
+    stage.alpha_args = {ac.a, ac.b, ac.c, ac.d};
+    stage.color_dest = cc.dest;
+    stage.alpha_dest = ac.dest;
+    stage.color_bias = s_BiasLUT[cc.bias];
+    stage.alpha_bias = s_BiasLUT[ac.bias];
+    stage.color_combiner = color_combiners[(cc.hex >> 16) & 63];
+    stage.alpha_combiner = alpha_combiners[(ac.hex >> 16) & 63];
+  }
+
+  // the results of the last tev stage are put onto the screen,
+  // regardless of the used destination register - TODO: Verify!
+  program.color_output = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
+  program.alpha_output = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
+
+  for (u32 alpha = 0; alpha < program.alpha_test_pass.size(); alpha++)
+    program.alpha_test_pass[alpha] = TevAlphaTest(alpha);
+
+  program.late_z = bpmem.GetEmulatedZ() == EmulatedZ::Late;
+
+  return program;
+}
+
+void Tev::ClearProgramCache()
+{
+  s_programs.clear();
+}
 
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+void Tev::Draw()
+{
+  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
+  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+
+  m_pixels_in++;
+
+  const Program& program = *m_program;
+
+  // initial color values
+  Reg = m_initial_regs;
+
+  for (unsigned int stageNum = 0; stageNum < program.num_indirect_stages; stageNum++)
+  {
+    const IndirectStage& stage = program.indirect_stages[stageNum];
+    TextureSampler::Sample(Uv[stage.texcoord].s >> stage.scale_s,
+                           Uv[stage.texcoord].t >> stage.scale_t, IndirectLod[stageNum],
+                           IndirectLinear[stageNum], stage.texmap, IndirectTex[stageNum]);
+  }
+
+  for (unsigned int stageNum = 0; stageNum < program.num_stages; stageNum++)
+  {
+    const Stage& stage = program.stages[stageNum];
+
+    if (stage.direct_texcoord)
+    {
+      // What Indirect does for a stage with an all zero tevind
+      AlphaBump = 0;
+      TexCoord.s = Uv[stage.texcoord].s;
+      TexCoord.t = Uv[stage.texcoord].t;
+    }
+    else
+    {
+      Indirect(stageNum, Uv[stage.texcoord].s, Uv[stage.texcoord].t);
+    }
 
     // sample texture
-    if (order.getEnable(stageOdd))
+    if (stage.texture_enabled)
     {
       // RGBA
       u8 texel[4];
 
-      if (bpmem.genMode.numtexgens > 0)
+      if (stage.sample_texture)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], stage.texmap, texel);
       }
       else
       {
@@ -470,81 +579,52 @@ void Tev::Draw()
       RawTexColor.b = texel[u32(ColorChannel::Blue)];
       RawTexColor.a = texel[u32(ColorChannel::Alpha)];
 
-      const auto& swap = bpmem.tevksel.GetSwapTable(ac.tswap);
-      TexColor.r = texel[u32(swap[ColorChannel::Red])];
-      TexColor.g = texel[u32(swap[ColorChannel::Green])];
-      TexColor.b = texel[u32(swap[ColorChannel::Blue])];
-      TexColor.a = texel[u32(swap[ColorChannel::Alpha])];
+      TexColor.r = texel[stage.tex_swap[u32(ColorChannel::Red)]];
+      TexColor.g = texel[stage.tex_swap[u32(ColorChannel::Green)]];
+      TexColor.b = texel[stage.tex_swap[u32(ColorChannel::Blue)]];
+      TexColor.a = texel[stage.tex_swap[u32(ColorChannel::Alpha)]];
     }
 
     // set konst for this stage
-    const auto kc = bpmem.tevksel.GetKonstColor(stageNum);
-    const auto ka = bpmem.tevksel.GetKonstAlpha(stageNum);
-    StageKonst.r = m_KonstLUT[kc].r;
-    StageKonst.g = m_KonstLUT[kc].g;
-    StageKonst.b = m_KonstLUT[kc].b;
-    StageKonst.a = m_KonstLUT[ka].a;
+    StageKonst.r = m_KonstLUT[stage.konst_color].r;
+    StageKonst.g = m_KonstLUT[stage.konst_color].g;
+    StageKonst.b = m_KonstLUT[stage.konst_color].b;
+    StageKonst.a = m_KonstLUT[stage.konst_alpha].a;
 
     // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap);
+    SetRasColor(stage);
 
     // combine inputs
+    const auto& [ca, cb, cc, cd] = stage.color_args;
+    const auto& [aa, ab, ac, ad] = stage.alpha_args;
     InputRegType inputs[4];
-    inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
-    inputs[BLU_C].b = m_ColorInputLUT[cc.b].b;
-    inputs[BLU_C].c = m_ColorInputLUT[cc.c].b;
-    inputs[BLU_C].d = m_ColorInputLUT[cc.d].b;
-    inputs[GRN_C].a = m_ColorInputLUT[cc.a].g;
-    inputs[GRN_C].b = m_ColorInputLUT[cc.b].g;
-    inputs[GRN_C].c = m_ColorInputLUT[cc.c].g;
-    inputs[GRN_C].d = m_ColorInputLUT[cc.d].g;
-    inputs[RED_C].a = m_ColorInputLUT[cc.a].r;
-    inputs[RED_C].b = m_ColorInputLUT[cc.b].r;
-    inputs[RED_C].c = m_ColorInputLUT[cc.c].r;
-    inputs[RED_C].d = m_ColorInputLUT[cc.d].r;
-    inputs[ALP_C].a = m_AlphaInputLUT[ac.a].a;
-    inputs[ALP_C].b = m_AlphaInputLUT[ac.b].a;
-    inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
-    inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
-
-    if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
-
-    if (cc.clamp)
-    {
-      Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
-    }
-    else
-    {
-      Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
-    }
-
-    if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
-
-    if (ac.clamp)
-      Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
-    else
-      Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+    inputs[BLU_C].a = m_ColorInputLUT[ca].b;
+    inputs[BLU_C].b = m_ColorInputLUT[cb].b;
+    inputs[BLU_C].c = m_ColorInputLUT[cc].b;
+    inputs[BLU_C].d = m_ColorInputLUT[cd].b;
+    inputs[GRN_C].a = m_ColorInputLUT[ca].g;
+    inputs[GRN_C].b = m_ColorInputLUT[cb].g;
+    inputs[GRN_C].c = m_ColorInputLUT[cc].g;
+    inputs[GRN_C].d = m_ColorInputLUT[cd].g;
+    inputs[RED_C].a = m_ColorInputLUT[ca].r;
+    inputs[RED_C].b = m_ColorInputLUT[cb].r;
+    inputs[RED_C].c = m_ColorInputLUT[cc].r;
+    inputs[RED_C].d = m_ColorInputLUT[cd].r;
+    inputs[ALP_C].a = m_AlphaInputLUT[aa].a;
+    inputs[ALP_C].b = m_AlphaInputLUT[ab].a;
+    inputs[ALP_C].c = m_AlphaInputLUT[ac].a;
+    inputs[ALP_C].d = m_AlphaInputLUT[ad].a;
+
+    // the combiners also clamp their result
+    (this->*stage.color_combiner)(stage, inputs);
+    (this->*stage.alpha_combiner)(stage, inputs);
   }
 
   // convert to 8 bits per component
-  // the results of the last tev stage are put onto the screen,
-  // regardless of the used destination register - TODO: Verify!
-  const auto& color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
-  const auto& alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
-  u8 output[4] = {(u8)Reg[alpha_index].a, (u8)Reg[color_index].b, (u8)Reg[color_index].g,
-                  (u8)Reg[color_index].r};
+  u8 output[4] = {(u8)Reg[program.alpha_output].a, (u8)Reg[program.color_output].b,
+                  (u8)Reg[program.color_output].g, (u8)Reg[program.color_output].r};
 
-  if (!TevAlphaTest(output[ALP_C]))
+  if (!program.alpha_test_pass[output[ALP_C]])
     return;
 
   // z texture
@@ -660,7 +740,7 @@ void Tev::Draw()
     output[BLU_C] = (output[BLU_C] * invFog + fogInt * bpmem.fog.color.b) >> 8;
   }
 
-  if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
+  if (program.late_z)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
@@ -673,10 +753,12 @@ void Tev::Draw()
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  m_bbox_left = std::min(m_bbox_left, static_cast<u16>(Position[0] & ~1));
+  m_bbox_right = std::max(m_bbox_right, static_cast<u16>(Position[0] | 1));
+  m_bbox_top = std::min(m_bbox_top, static_cast<u16>(Position[1] & ~1));
+  m_bbox_bottom = std::max(m_bbox_bottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
+  m_pixels_out++;
   EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
@@ -695,3 +777,34 @@ void Tev::SetKonstColors()
     KonstantColors[i].a = pixel_shader_manager.constants.kcolors[i][3];
   }
 }
+
+void Tev::SetProgram(const Program& program)
+{
+  m_program = &program;
+
+  auto& system = Core::System::GetInstance();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+
+  for (int i = 0; i < 4; i++)
+  {
+    m_initial_regs[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
+    m_initial_regs[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
+    m_initial_regs[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
+    m_initial_regs[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
+  }
+}
+
+void Tev::FlushStats()
+{
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, m_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, m_pixels_out);
+  if (m_pixels_out != 0)
+    BBoxManager::Update(m_bbox_left, m_bbox_right, m_bbox_top, m_bbox_bottom);
+
+  m_pixels_in = 0;
+  m_pixels_out = 0;
+  m_bbox_left = 0xffff;
+  m_bbox_right = 0;
+  m_bbox_top = 0xffff;
+  m_bbox_bottom = 0;
+}
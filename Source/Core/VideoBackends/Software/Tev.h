@@ -4,6 +4,9 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
 
 #include "Common/EnumMap.h"
 #include "VideoCommon/BPMemory.h"
@@ -204,16 +207,106 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, u32 swaptable);
+  struct Stage;
+  using CombinerFunc = void (Tev::*)(const Stage& stage, const InputRegType inputs[4]);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
-  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  struct IndirectStage
+  {
+    u8 texcoord;
+    u8 texmap;
+    u8 scale_s;
+    u8 scale_t;
+  };
+
+  // [emubench] One TEV stage with its BP registers decoded and its combiners picked
+  struct Stage
+  {
+    u8 texcoord;
+    u8 texmap;
+    // tevind is all zero, so the stage's texture coordinate is the regular one
+    bool direct_texcoord;
+    bool texture_enabled;
+    bool sample_texture;
+    std::array<u8, 4> tex_swap;
+
+    RasColorChan ras_channel;
+    std::array<u8, 4> ras_swap;
+
+    KonstSel konst_color;
+    KonstSel konst_alpha;
+
+    std::array<TevColorArg, 4> color_args;
+    std::array<TevAlphaArg, 4> alpha_args;
+    TevOutput color_dest;
+    TevOutput alpha_dest;
+    s16 color_bias;
+    s16 alpha_bias;
+    CombinerFunc color_combiner;
+    CombinerFunc alpha_combiner;
+  };
+
+  template <TevOp op, TevScale scale, bool clamp>
+  void DrawColorRegular(const Stage& stage, const InputRegType inputs[4]);
+  template <TevComparison comparison, TevCompareMode mode, bool clamp>
+  void DrawColorCompare(const Stage& stage, const InputRegType inputs[4]);
+  template <TevOp op, TevScale scale, bool clamp>
+  void DrawAlphaRegular(const Stage& stage, const InputRegType inputs[4]);
+  template <TevComparison comparison, TevCompareMode mode, bool clamp>
+  void DrawAlphaCompare(const Stage& stage, const InputRegType inputs[4]);
+
+  // Every instantiation of the above, indexed by bits 16-21 (bias, op, clamp, scale) of a combiner
+  template <size_t... I>
+  static constexpr std::array<CombinerFunc, sizeof...(I)>
+  MakeColorCombiners(std::index_sequence<I...>);
+  template <size_t... I>
+  static constexpr std::array<CombinerFunc, sizeof...(I)>
+  MakeAlphaCombiners(std::index_sequence<I...>);
+
+  void SetRasColor(const Stage& stage);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  // [emubench] Kept per Tev rather than in g_stats and BBoxManager, as each rasterizer thread has
+  // its own Tev. FlushStats hands them over.
+  u32 m_pixels_in = 0;
+  u32 m_pixels_out = 0;
+  u16 m_bbox_left = 0xffff;
+  u16 m_bbox_right = 0;
+  u16 m_bbox_top = 0xffff;
+  u16 m_bbox_bottom = 0;
+
 public:
+  // [emubench] The TEV configuration in bpmem with everything that doesn't vary per pixel
+  // resolved, built once per distinct configuration and reused like a GPU backend's shaders.
+  struct Program
+  {
+    u32 num_indirect_stages;
+    u32 num_stages;
+    std::array<IndirectStage, 4> indirect_stages;
+    std::array<Stage, 16> stages;
+    TevOutput color_output;
+    TevOutput alpha_output;
+    std::array<bool, 256> alpha_test_pass;
+    bool late_z;
+  };
+
+  // The BP registers a Program is built from
+  class ProgramUID
+  {
+    std::array<u32, 71> words{};
+    size_t hash = 0;
+
+  public:
+    ProgramUID();
+
+    bool operator==(const ProgramUID& rh) const { return words == rh.words; }
+    size_t GetHash() const { return hash; }
+  };
+
+  // Program for the current bpmem, from the cache if it has been seen before. Video thread only.
+  static const Program& GetProgram();
+  static void ClearProgramCache();
+
   s32 Position[3]{};
   u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
   TextureCoordinateType Uv[8]{};
@@ -231,5 +324,18 @@ public:
   };
 
   void SetKonstColors();
+  void SetProgram(const Program& program);
   void Draw();
+  void FlushStats();
+
+private:
+  // [emubench] Set once per batch, as bpmem and the shader constants don't change within one
+  const Program* m_program = nullptr;
+  Common::EnumMap<TevColor, TevOutput::Color2> m_initial_regs;
+};
+
+template <>
+struct std::hash<Tev::ProgramUID>
+{
+  size_t operator()(const Tev::ProgramUID& uid) const noexcept { return uid.GetHash(); }
 };
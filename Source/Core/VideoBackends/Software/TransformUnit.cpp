@@ -9,7 +9,9 @@
 #include <cstring>
 
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -20,6 +22,29 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/XFMemory.h"
 
+// [emubench] Batched position and normal transforms, see TransformUnitImpl.h
+#if defined(_M_X86) || defined(_M_X86_64)
+#define USE_SSE
+#elif defined(_M_ARM_64)
+#define USE_NEON
+#else
+#define NO_SIMD
+#endif
+
+#if defined(USE_SSE)
+#include <immintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#ifndef NO_SIMD
+#include "VideoBackends/Software/TransformUnitImpl.h"
+#endif
+#ifdef USE_SSE
+#define USE_AVX
+#include "VideoBackends/Software/TransformUnitImpl.h"
+#endif
+
 namespace TransformUnit
 {
 static void MultiplyVec2Mat24(const Vec3& vec, const float* mat, Vec3& result)
@@ -444,4 +469,59 @@ void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst)
     dst->texCoords[coordNum][1] *= (bpmem.texcoords[coordNum].t.scale_minus_1 + 1);
   }
 }
+
+void InputVertexBatch::Clear()
+{
+  vertices.clear();
+  for (auto& component : position)
+    component.clear();
+  for (auto& normal_components : normal)
+  {
+    for (auto& component : normal_components)
+      component.clear();
+  }
+}
+
+void InputVertexBatch::Add(const InputVertexData& vertex)
+{
+  vertices.push_back(vertex);
+  for (int i = 0; i < 3; i++)
+  {
+    position[i].push_back(vertex.position[i]);
+    for (int n = 0; n < 3; n++)
+      normal[n][i].push_back(vertex.normal[n][i]);
+  }
+}
+
+void TransformBatch(const InputVertexBatch& src, OutputVertexData* dst)
+{
+#if defined(USE_SSE)
+  if (cpu_info.bAVX)
+  {
+    TransformUnit_AVX::TransformPositions(src, dst);
+    TransformUnit_AVX::TransformNormals(src, dst);
+  }
+  else
+  {
+    TransformUnit_SSE::TransformPositions(src, dst);
+    TransformUnit_SSE::TransformNormals(src, dst);
+  }
+#elif defined(USE_NEON)
+  TransformUnit_NEON::TransformPositions(src, dst);
+  TransformUnit_NEON::TransformNormals(src, dst);
+#else
+  for (size_t i = 0; i < src.vertices.size(); i++)
+  {
+    TransformPosition(&src.vertices[i], &dst[i]);
+    TransformNormal(&src.vertices[i], &dst[i]);
+  }
+#endif
+
+  // Lighting and texgens depend on too much per-channel state to be worth vectorizing
+  for (size_t i = 0; i < src.vertices.size(); i++)
+  {
+    TransformColor(&src.vertices[i], &dst[i]);
+    TransformTexCoord(&src.vertices[i], &dst[i]);
+  }
+}
 }  // namespace TransformUnit
@@ -3,8 +3,10 @@
 
 #pragma once
 
-struct InputVertexData;
-struct OutputVertexData;
+#include <array>
+#include <vector>
+
+#include "VideoBackends/Software/NativeVertexFormat.h"
 
 namespace TransformUnit
 {
@@ -12,4 +14,19 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst);
 void TransformNormal(const InputVertexData* src, OutputVertexData* dst);
 void TransformColor(const InputVertexData* src, OutputVertexData* dst);
 void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst);
+
+// [emubench] The decoded vertices of a draw. Positions and normals are also stored one array per
+// component, so that they can be transformed several vertices at a time.
+struct InputVertexBatch
+{
+  std::vector<InputVertexData> vertices;
+  std::array<std::vector<float>, 3> position;
+  std::array<std::array<std::vector<float>, 3>, 3> normal;
+
+  void Clear();
+  void Add(const InputVertexData& vertex);
+};
+
+// Same results as running the four functions above on every vertex
+void TransformBatch(const InputVertexBatch& src, OutputVertexData* dst);
 }  // namespace TransformUnit
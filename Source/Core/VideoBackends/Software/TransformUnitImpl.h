@@ -0,0 +1,270 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// [emubench] Position and normal transforms over a whole InputVertexBatch, one vector of vertices
+// at a time. The operations are done in the same order as the scalar code, without fused
+// multiply-adds, so the results match it bit for bit.
+
+#if defined(USE_AVX)
+#define VECTOR_NAMESPACE TransformUnit_AVX
+#elif defined(USE_SSE)
+#define VECTOR_NAMESPACE TransformUnit_SSE
+#elif defined(USE_NEON)
+#define VECTOR_NAMESPACE TransformUnit_NEON
+#else
+#error This file is meant to be used by TransformUnit.cpp only!
+#endif
+
+#if defined(__GNUC__) && defined(USE_AVX) && !defined(__AVX__)
+#define ATTR_TARGET __attribute__((target("avx")))
+#else
+#define ATTR_TARGET
+#endif
+
+namespace VECTOR_NAMESPACE
+{
+#if defined(USE_AVX)
+typedef __m256 Vector;
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Load(const float* src)
+{
+  return _mm256_loadu_ps(src);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void Store(float* dst, Vector v)
+{
+  _mm256_storeu_ps(dst, v);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Broadcast(float f)
+{
+  return _mm256_set1_ps(f);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Add(Vector a, Vector b)
+{
+  return _mm256_add_ps(a, b);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Mul(Vector a, Vector b)
+{
+  return _mm256_mul_ps(a, b);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Div(Vector a, Vector b)
+{
+  return _mm256_div_ps(a, b);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Sqrt(Vector v)
+{
+  return _mm256_sqrt_ps(v);
+}
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector Negate(Vector v)
+{
+  return _mm256_xor_ps(v, _mm256_set1_ps(-0.0f));
+}
+#elif defined(USE_SSE)
+typedef __m128 Vector;
+
+DOLPHIN_FORCE_INLINE static Vector Load(const float* src)
+{
+  return _mm_loadu_ps(src);
+}
+DOLPHIN_FORCE_INLINE static void Store(float* dst, Vector v)
+{
+  _mm_storeu_ps(dst, v);
+}
+DOLPHIN_FORCE_INLINE static Vector Broadcast(float f)
+{
+  return _mm_set1_ps(f);
+}
+DOLPHIN_FORCE_INLINE static Vector Add(Vector a, Vector b)
+{
+  return _mm_add_ps(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Mul(Vector a, Vector b)
+{
+  return _mm_mul_ps(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Div(Vector a, Vector b)
+{
+  return _mm_div_ps(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Sqrt(Vector v)
+{
+  return _mm_sqrt_ps(v);
+}
+DOLPHIN_FORCE_INLINE static Vector Negate(Vector v)
+{
+  return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+}
+#elif defined(USE_NEON)
+typedef float32x4_t Vector;
+
+DOLPHIN_FORCE_INLINE static Vector Load(const float* src)
+{
+  return vld1q_f32(src);
+}
+DOLPHIN_FORCE_INLINE static void Store(float* dst, Vector v)
+{
+  vst1q_f32(dst, v);
+}
+DOLPHIN_FORCE_INLINE static Vector Broadcast(float f)
+{
+  return vdupq_n_f32(f);
+}
+DOLPHIN_FORCE_INLINE static Vector Add(Vector a, Vector b)
+{
+  return vaddq_f32(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Mul(Vector a, Vector b)
+{
+  return vmulq_f32(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Div(Vector a, Vector b)
+{
+  return vdivq_f32(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Sqrt(Vector v)
+{
+  return vsqrtq_f32(v);
+}
+DOLPHIN_FORCE_INLINE static Vector Negate(Vector v)
+{
+  return vnegq_f32(v);
+}
+#endif
+
+static constexpr size_t WIDTH = sizeof(Vector) / sizeof(float);
+
+// Element `index` of every lane's matrix. Most draws use one matrix for all their vertices.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector LoadMatrixElement(const float* const* matrices,
+                                                                 bool uniform, int index)
+{
+  if (uniform)
+    return Broadcast(matrices[0][index]);
+
+  alignas(32) float lanes[WIDTH];
+  for (size_t lane = 0; lane < WIDTH; lane++)
+    lanes[lane] = matrices[lane][index];
+  return Load(lanes);
+}
+
+ATTR_TARGET static void TransformPositions(const TransformUnit::InputVertexBatch& src,
+                                           OutputVertexData* dst)
+{
+  const size_t count = src.vertices.size();
+  const Projection::Raw& proj = xfmem.projection.rawProjection;
+  const bool perspective = xfmem.projection.type == ProjectionType::Perspective;
+
+  size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH)
+  {
+    const float* matrices[WIDTH];
+    bool uniform = true;
+    for (size_t lane = 0; lane < WIDTH; lane++)
+    {
+      matrices[lane] = &xfmem.posMatrices[src.vertices[i + lane].posMtx * 4];
+      uniform &= matrices[lane] == matrices[0];
+    }
+
+    Vector mat[12];
+    for (int j = 0; j < 12; j++)
+      mat[j] = LoadMatrixElement(matrices, uniform, j);
+
+    const Vector x = Load(&src.position[0][i]);
+    const Vector y = Load(&src.position[1][i]);
+    const Vector z = Load(&src.position[2][i]);
+
+    Vector out[7];
+    out[0] = Add(Add(Add(Mul(mat[0], x), Mul(mat[1], y)), Mul(mat[2], z)), mat[3]);
+    out[1] = Add(Add(Add(Mul(mat[4], x), Mul(mat[5], y)), Mul(mat[6], z)), mat[7]);
+    out[2] = Add(Add(Add(Mul(mat[8], x), Mul(mat[9], y)), Mul(mat[10], z)), mat[11]);
+
+    if (perspective)
+    {
+      out[3] = Add(Mul(Broadcast(proj[0]), out[0]), Mul(Broadcast(proj[1]), out[2]));
+      out[4] = Add(Mul(Broadcast(proj[2]), out[1]), Mul(Broadcast(proj[3]), out[2]));
+      out[5] = Mul(Add(Mul(Broadcast(proj[4]), out[2]), Broadcast(proj[5])),
+                   Broadcast(1.0f - (float)1e-7));
+      out[6] = Negate(out[2]);
+    }
+    else
+    {
+      out[3] = Add(Mul(Broadcast(proj[0]), out[0]), Broadcast(proj[1]));
+      out[4] = Add(Mul(Broadcast(proj[2]), out[1]), Broadcast(proj[3]));
+      out[5] = Add(Mul(Broadcast(proj[4]), out[2]), Broadcast(proj[5]));
+      out[6] = Broadcast(1.0f);
+    }
+
+    alignas(32) float lanes[7][WIDTH];
+    for (int j = 0; j < 7; j++)
+      Store(lanes[j], out[j]);
+
+    for (size_t lane = 0; lane < WIDTH; lane++)
+    {
+      OutputVertexData& vertex = dst[i + lane];
+      vertex.mvPosition = Vec3(lanes[0][lane], lanes[1][lane], lanes[2][lane]);
+      vertex.projectedPosition = {lanes[3][lane], lanes[4][lane], lanes[5][lane], lanes[6][lane]};
+    }
+  }
+
+  for (; i < count; i++)
+    TransformUnit::TransformPosition(&src.vertices[i], &dst[i]);
+}
+
+ATTR_TARGET static void TransformNormals(const TransformUnit::InputVertexBatch& src,
+                                         OutputVertexData* dst)
+{
+  const size_t count = src.vertices.size();
+
+  size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH)
+  {
+    const float* matrices[WIDTH];
+    bool uniform = true;
+    for (size_t lane = 0; lane < WIDTH; lane++)
+    {
+      matrices[lane] = &xfmem.normalMatrices[(src.vertices[i + lane].posMtx & 31) * 3];
+      uniform &= matrices[lane] == matrices[0];
+    }
+
+    Vector mat[9];
+    for (int j = 0; j < 9; j++)
+      mat[j] = LoadMatrixElement(matrices, uniform, j);
+
+    alignas(32) float lanes[3][3][WIDTH];
+    for (int n = 0; n < 3; n++)
+    {
+      const Vector x = Load(&src.normal[n][0][i]);
+      const Vector y = Load(&src.normal[n][1][i]);
+      const Vector z = Load(&src.normal[n][2][i]);
+
+      Vector out_x = Add(Add(Mul(mat[0], x), Mul(mat[1], y)), Mul(mat[2], z));
+      Vector out_y = Add(Add(Mul(mat[3], x), Mul(mat[4], y)), Mul(mat[5], z));
+      Vector out_z = Add(Add(Mul(mat[6], x), Mul(mat[7], y)), Mul(mat[8], z));
+
+      // Only the first normal is normalized, see TransformNormal
+      if (n == 0)
+      {
+        const Vector length2 = Add(Add(Mul(out_x, out_x), Mul(out_y, out_y)), Mul(out_z, out_z));
+        const Vector inverse = Div(Broadcast(1.0f), Sqrt(length2));
+        out_x = Mul(out_x, inverse);
+        out_y = Mul(out_y, inverse);
+        out_z = Mul(out_z, inverse);
+      }
+
+      Store(lanes[n][0], out_x);
+      Store(lanes[n][1], out_y);
+      Store(lanes[n][2], out_z);
+    }
+
+    for (size_t lane = 0; lane < WIDTH; lane++)
+    {
+      for (int n = 0; n < 3; n++)
+        dst[i + lane].normal[n] = Vec3(lanes[n][0][lane], lanes[n][1][lane], lanes[n][2][lane]);
+    }
+  }
+
+  for (; i < count; i++)
+    TransformUnit::TransformNormal(&src.vertices[i], &dst[i]);
+}
+}  // namespace VECTOR_NAMESPACE
+
+#undef ATTR_TARGET
+#undef VECTOR_NAMESPACE
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -30,6 +31,55 @@ static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
                                             Config::Get(Config::GFX_PNG_COMPRESSION_LEVEL));
 }
 
+// [emubench] Appends a frame to an in-memory capture. The readback texture is reused next frame,
+// so this is the one copy the frame needs.
+static void AppendFrameData(const FrameData& frame, bool grayscale, CapturedFrame* destination)
+{
+  const u32 channels = grayscale ? 1 : 4;
+  const size_t row_size = static_cast<size_t>(frame.width) * channels;
+  const size_t layer_size = row_size * frame.height;
+
+  // A size change mid-stack (e.g. the game switching modes) restarts the stack
+  if (destination->width != static_cast<u32>(frame.width) ||
+      destination->height != static_cast<u32>(frame.height))
+  {
+    destination->layers = 0;
+  }
+  destination->width = frame.width;
+  destination->height = frame.height;
+  destination->channels = channels;
+  destination->pixels.resize(layer_size * (destination->layers + 1));
+  u8* dest = destination->pixels.data() + layer_size * destination->layers;
+  destination->layers++;
+
+  if (grayscale)
+  {
+    for (int y = 0; y < frame.height; ++y)
+    {
+      const u8* src = frame.data + static_cast<size_t>(y) * frame.stride;
+      u8* dest_row = dest + y * row_size;
+      for (int x = 0; x < frame.width; ++x)
+      {
+        // BT.601 luma in 8.8 fixed point
+        const u8* px = src + x * 4;
+        dest_row[x] = static_cast<u8>((px[0] * 77 + px[1] * 150 + px[2] * 29) >> 8);
+      }
+    }
+    return;
+  }
+
+  if (static_cast<size_t>(frame.stride) == row_size)
+  {
+    std::memcpy(dest, frame.data, layer_size);
+    return;
+  }
+
+  for (int y = 0; y < frame.height; ++y)
+  {
+    std::memcpy(dest + y * row_size, frame.data + static_cast<size_t>(y) * frame.stride, row_size);
+  }
+}
+
 FrameDumper::FrameDumper()
 {
   m_frame_end_handle =
@@ -256,19 +306,43 @@ void FrameDumper::FrameDumpThreadFunc()
     {
       std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
+      bool capture_complete = true;
+      if (m_capture_frame)
+      {
+        AppendFrameData(frame, m_capture_params.grayscale, m_capture_frame.get());
+        // [emubench] Stacked observations keep the request up for the following frames
+        capture_complete = m_capture_frame->layers >= m_capture_params.stack;
+        if (capture_complete)
+        {
+          m_capture_frame->complete.Set();
+          m_capture_frame.reset();
+        }
+        else
+          m_screenshot_request.Set();
+      }
+      else if (m_screenshot_name.empty())
+      {
+        // [emubench] Cancelled while this thread was waiting for the lock
+        capture_complete = false;
+      }
+      else if (DumpFrameToPNG(frame, m_screenshot_name))
+      {
         OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // [emubench]
-      if (m_external_screenshot_completed) {
-        m_external_screenshot_completed->Set();
-        m_external_screenshot_completed = nullptr;
-        NOTICE_LOG_FMT(CORE, "IPC: Queued screenshot saved successfully");
       }
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
+      if (capture_complete)
+      {
+        // [emubench]
+        if (m_external_screenshot_completed) {
+          m_external_screenshot_completed->Set();
+          m_external_screenshot_completed = nullptr;
+          NOTICE_LOG_FMT(CORE, "IPC: Queued screenshot saved successfully");
+        }
+
+        // Reset settings
+        m_screenshot_name.clear();
+        m_screenshot_completed.Set();
+      }
     }
 
     if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
@@ -379,6 +453,7 @@ void FrameDumper::SaveScreenshot(std::string filename)
 {
   std::lock_guard<std::mutex> lk(m_screenshot_lock);
   m_screenshot_name = std::move(filename);
+  m_capture_frame.reset();
   m_screenshot_request.Set();
 }
 
@@ -386,10 +461,49 @@ void FrameDumper::SaveScreenshot(std::string filename)
 void FrameDumper::SaveScreenshotWithCallback(std::string filename, Common::Event* completion_event) {
   std::lock_guard<std::mutex> lk(m_screenshot_lock);
   m_screenshot_name = std::move(filename);
+  m_capture_frame.reset();
+  m_external_screenshot_completed = completion_event;
+  m_screenshot_request.Set();
+}
+
+// [emubench]
+void FrameDumper::CaptureFrameWithCallback(std::shared_ptr<CapturedFrame> frame,
+                                           Common::Event* completion_event,
+                                           const ObservationParams& params)
+{
+  std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  m_screenshot_name.clear();
+  m_capture_frame = std::move(frame);
+  m_capture_frame->layers = 0;
+  m_capture_params = params;
+  m_capture_params.stack = std::max(m_capture_params.stack, 1u);
   m_external_screenshot_completed = completion_event;
   m_screenshot_request.Set();
 }
 
+// [emubench]
+bool FrameDumper::CancelScreenshot(const Common::Event* completion_event)
+{
+  std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  if (!completion_event || m_external_screenshot_completed != completion_event)
+    return false;
+
+  m_screenshot_request.Clear();
+  m_screenshot_name.clear();
+  m_capture_frame.reset();
+  m_external_screenshot_completed = nullptr;
+  return true;
+}
+
+// [emubench]
+std::optional<ObservationParams> FrameDumper::GetPendingObservation()
+{
+  std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  if (!m_capture_frame)
+    return std::nullopt;
+  return m_capture_params;
+}
+
 bool FrameDumper::IsFrameDumping() const
 {
   // [emubench]
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -18,6 +20,36 @@ class AbstractStagingTexture;
 class AbstractTexture;
 class AbstractFramebuffer;
 
+// [emubench] Per-capture shaping of an observation. Crop and resize happen in the presenter's
+// post-processing blit so only the small image is read back; grayscale is applied while copying
+// the readback out.
+struct ObservationParams
+{
+  // Output size in pixels; 0 keeps the size of the cropped source
+  u32 width = 0;
+  u32 height = 0;
+  // Crop in normalized [0, 1] coordinates of the XFB
+  MathUtil::Rectangle<float> crop{0.0f, 0.0f, 1.0f, 1.0f};
+  bool grayscale = false;
+  // Consecutive frames captured into one observation
+  u32 stack = 1;
+};
+
+// [emubench] A frame handed to the IPC layer in memory instead of being written as a PNG
+struct CapturedFrame
+{
+  u32 width = 0;
+  u32 height = 0;
+  // 4 for RGBA8, 1 for 8-bit luma
+  u32 channels = 4;
+  // Number of frames captured so far, stored one after another
+  u32 layers = 0;
+  // Tightly packed rows, top row first
+  std::vector<u8> pixels;
+  // Set by the dump thread once every layer is in. Nothing else may be read before then.
+  Common::Flag complete;
+};
+
 class FrameDumper
 {
 public:
@@ -36,6 +68,16 @@ public:
 
   // [emubench]
   void SaveScreenshotWithCallback(std::string filename, Common::Event* completion_event);
+  // [emubench] Like SaveScreenshotWithCallback, but the frame is copied into `frame` and nothing
+  // is encoded or written to disk.
+  void CaptureFrameWithCallback(std::shared_ptr<CapturedFrame> frame,
+                                Common::Event* completion_event,
+                                const ObservationParams& params = {});
+  // [emubench] Drops the pending request that would set `completion_event`, so the caller can free
+  // it. Returns false if there is none, i.e. the event was already set or the request replaced.
+  bool CancelScreenshot(const Common::Event* completion_event);
+  // [emubench] Shaping for the pending in-memory capture, if there is one
+  std::optional<ObservationParams> GetPendingObservation();
 
   bool IsFrameDumping() const;
   // [emubench] Check if there's a pending screenshot request (for early exit in ProcessFrameDumping)
@@ -111,6 +153,8 @@ private:
 
   // [emubench]
   Common::Event* m_external_screenshot_completed = nullptr;
+  std::shared_ptr<CapturedFrame> m_capture_frame;
+  ObservationParams m_capture_params;
 
   // [emubench] Buffer for flipping pixel rows in OpenGL (lower-left origin backends)
   std::vector<u8> m_flipped_frame_buffer;
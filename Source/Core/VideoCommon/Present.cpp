@@ -3,6 +3,9 @@
 
 #include "VideoCommon/Present.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Common/ChunkFile.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
@@ -19,6 +22,7 @@
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OnScreenUI.h"
 #include "VideoCommon/PostProcessing.h"
+#include "VideoCommon/RenderSkip.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VideoEvents.h"
@@ -200,8 +204,12 @@ void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
 
   if (!is_duplicate || !g_ActiveConfig.bSkipPresentingDuplicateXFBs)
   {
-    Present(presentation_time);
-    ProcessFrameDumping(ticks);
+    // [emubench] Skipped frames leave the XFB stale, so neither show nor capture it
+    if (g_render_skip.IsOutputComplete())
+    {
+      Present(presentation_time);
+      ProcessFrameDumping(ticks);
+    }
 
     AfterPresentEvent::Trigger(present_info);
   }
@@ -219,8 +227,12 @@ void Presenter::ImmediateSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_
 
   BeforePresentEvent::Trigger(present_info);
 
-  Present();
-  ProcessFrameDumping(ticks);
+  // [emubench] See ViSwap
+  if (g_render_skip.IsOutputComplete())
+  {
+    Present();
+    ProcessFrameDumping(ticks);
+  }
 
   AfterPresentEvent::Trigger(present_info);
 }
@@ -292,6 +304,30 @@ void Presenter::ProcessFrameDumping(u64 ticks) const
     target_rect.right = width;
     target_rect.bottom = height;
 
+    // [emubench] Observation captures crop the XFB and scale straight to the requested size in the
+    // post-processing blit below, so the readback and everything after it only see the small image.
+    // Not while recording video, which needs a fixed frame size.
+    MathUtil::Rectangle<int> source_rect = m_xfb_rect;
+    const std::optional<ObservationParams> observation = g_frame_dumper->GetPendingObservation();
+    if (observation && !Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+    {
+      const int xfb_width = m_xfb_rect.GetWidth();
+      const int xfb_height = m_xfb_rect.GetHeight();
+      const auto scale = [](int extent, float fraction) {
+        return std::clamp(static_cast<int>(std::lround(extent * fraction)), 0, extent);
+      };
+      source_rect.left = m_xfb_rect.left + scale(xfb_width, observation->crop.left);
+      source_rect.top = m_xfb_rect.top + scale(xfb_height, observation->crop.top);
+      source_rect.right = std::max(m_xfb_rect.left + scale(xfb_width, observation->crop.right),
+                                   source_rect.left + 1);
+      source_rect.bottom = std::max(m_xfb_rect.top + scale(xfb_height, observation->crop.bottom),
+                                    source_rect.top + 1);
+
+      width = observation->width ? static_cast<int>(observation->width) : source_rect.GetWidth();
+      height = observation->height ? static_cast<int>(observation->height) : source_rect.GetHeight();
+      target_rect = MathUtil::Rectangle<int>(0, 0, width, height);
+    }
+
     // [emubench] Create or verify screenshot texture/framebuffer for post-processing
     // This ensures screenshots capture the output with shaders applied
     if (!m_screenshot_texture || m_screenshot_texture->GetWidth() != static_cast<u32>(width) ||
@@ -326,7 +362,7 @@ void Presenter::ProcessFrameDumping(u64 ticks) const
     g_gfx->SetViewportAndScissor(target_rect);
 
     // Render the XFB texture with post-processing applied
-    m_post_processor->BlitFromTexture(target_rect, m_xfb_rect, m_xfb_entry->texture.get());
+    m_post_processor->BlitFromTexture(target_rect, source_rect, m_xfb_entry->texture.get());
 
     // [emubench] Ensure GPU completes rendering before we copy the texture
     g_gfx->Flush();
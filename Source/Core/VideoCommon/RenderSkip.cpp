@@ -0,0 +1,53 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/RenderSkip.h"
+
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/FrameDumper.h"
+#include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/VideoEvents.h"
+
+RenderSkip g_render_skip;
+
+static Common::EventHook s_after_frame_event =
+    AfterFrameEvent::Register([](Core::System&) { g_render_skip.OnFrameEnd(); }, "RenderSkip");
+
+bool RenderSkip::IsSkippingDraws() const
+{
+  if (!m_skipping.load(std::memory_order_relaxed))
+    return false;
+
+  // Bounding box values are read back by the game, and come from rasterizing the primitives
+  return !g_ActiveConfig.bBBoxEnable || !g_bounding_box || !g_bounding_box->IsEnabled();
+}
+
+// Readbacks are only seen once the frame's draws are gone, too late to render them, so this goes by
+// the settings that allow them instead
+bool RenderSkip::CanGameReadEFB()
+{
+  const bool copy_to_vram =
+      g_backend_info.bSupportsCopyToVram && !g_ActiveConfig.bDisableCopyToVRAM;
+  return !g_ActiveConfig.bSkipEFBCopyToRam || !copy_to_vram || g_ActiveConfig.bEFBAccessEnable;
+}
+
+void RenderSkip::OnFrameEnd()
+{
+  if (m_skipping.load(std::memory_order_relaxed))
+  {
+    m_rendered_frames = 0;
+    m_skipped_frames.fetch_add(1, std::memory_order_relaxed);
+  }
+  else if (m_rendered_frames < WARMUP_FRAMES)
+  {
+    ++m_rendered_frames;
+  }
+
+  const bool observed = (g_frame_dumper && g_frame_dumper->HasPendingScreenshot()) ||
+                        Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES);
+  m_skipping.store(g_ActiveConfig.bSkipUnobservedFrames && !CanGameReadEFB() && !observed,
+                   std::memory_order_relaxed);
+}
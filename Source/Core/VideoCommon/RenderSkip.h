@@ -0,0 +1,44 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+// [emubench] Fast-forwarding through frames nobody looks at. While a frame is skipped, FIFO
+// commands are still processed for their side effects (BP/CP/XF state, EFB copies, PE tokens and
+// finish), but primitives are dropped before vertex loading and the frame is never presented, so
+// the render window shows the last rendered frame. Rendering resumes for frames with a pending
+// screenshot and while dumping video. Nothing is skipped while the game could read the EFB back,
+// since a skipped frame's EFB would differ from a rendered one by the time it is read.
+class RenderSkip final
+{
+public:
+  // Frames rendered before a frame counts as complete, so render-to-texture effects that feed
+  // into the next frame have caught up again
+  static constexpr u32 WARMUP_FRAMES = 2;
+
+  // Whether primitives of the current frame are dropped instead of rasterized
+  bool IsSkippingDraws() const;
+
+  // Whether the last WARMUP_FRAMES finished frames were all rendered. Only complete frames are
+  // presented or captured, so a screenshot request waits for one.
+  bool IsOutputComplete() const { return m_rendered_frames >= WARMUP_FRAMES; }
+
+  // Called at the end of each frame, decides whether the next one is skipped
+  void OnFrameEnd();
+
+  u64 GetSkippedFrames() const { return m_skipped_frames.load(std::memory_order_relaxed); }
+
+private:
+  // Whether EFB contents can reach emulated RAM, through EFB copies to RAM or EFB peeks
+  static bool CanGameReadEFB();
+
+  std::atomic<bool> m_skipping = false;
+  std::atomic<u64> m_skipped_frames = 0;
+  u32 m_rendered_frames = WARMUP_FRAMES;
+};
+
+extern RenderSkip g_render_skip;
@@ -5,9 +5,12 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <span>
 
 #include "Common/CommonTypes.h"
+#include "Common/JobPool.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
 #include "Common/Swap.h"
@@ -15,6 +18,7 @@
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureDecoder_Util.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/sfont.inc"
 
 static bool TexFmt_Overlay_Enable = false;
@@ -298,10 +302,53 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+// Smaller textures decode faster than the workers wake up
+constexpr int MIN_THREADED_DECODE_TEXELS = 256 * 256;
+
+// Only one texture is split at a time, other callers decode on their own thread
+static std::mutex s_decode_workers_mutex;
+static std::unique_ptr<Common::JobPool> s_decode_workers;
+
+// Splits the texture into strips of whole block rows, which are contiguous in the source data
+static bool DecodeThreaded(u8* dst, const u8* src, int width, int height,
+                           TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  const u32 num_threads = g_ActiveConfig.GetTextureDecodeThreads();
+  if (num_threads <= 1 || width * height < MIN_THREADED_DECODE_TEXELS)
+    return false;
+
+  std::unique_lock<std::mutex> lk(s_decode_workers_mutex, std::try_to_lock);
+  if (!lk.owns_lock())
+    return false;
+
+  if (!s_decode_workers || s_decode_workers->GetNumThreads() != num_threads)
+  {
+    s_decode_workers.reset();
+    s_decode_workers = std::make_unique<Common::JobPool>(num_threads - 1, "Texture Decoder");
+  }
+
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  const int block_rows = (height + block_height - 1) / block_height;
+  const u32 num_strips = std::min(num_threads, static_cast<u32>(block_rows));
+  const int strip_height = (block_rows + num_strips - 1) / num_strips * block_height;
+
+  s_decode_workers->Run(num_strips, [&](size_t strip, u32) {
+    const int y = static_cast<int>(strip) * strip_height;
+    const int rows = std::min(strip_height, height - y);
+    if (rows <= 0)
+      return;
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst) + y * width,
+                           src + TexDecoder_GetTextureSizeInBytes(width, y, texformat), width, rows,
+                           texformat, tlut, tlutfmt);
+  });
+  return true;
+}
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  if (!DecodeThreaded(dst, src, width, height, texformat, tlut, tlutfmt))
+    _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
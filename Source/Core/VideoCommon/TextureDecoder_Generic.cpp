@@ -4,16 +4,31 @@
 #include "VideoCommon/TextureDecoder.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
 #include "Common/Swap.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder_Util.h"
 #include "VideoCommon/VideoConfig.h"
 
+// [emubench] This file is also what generic builds use on x86-64, where _M_X86_64 is not defined,
+// so check what the compiler targets instead.
+#if defined(_M_X86_64) || defined(__SSE2__) || defined(_M_X64)
+#define USE_SSE
+#include <emmintrin.h>
+#elif defined(_M_ARM_64) || defined(__aarch64__) || defined(_M_ARM64)
+#define USE_NEON
+#include <arm_neon.h>
+#else
+#define NO_SIMD
+#endif
+
 // GameCube/Wii texture decoder
 
 // Decodes all known GameCube/Wii texture formats.
@@ -125,6 +140,411 @@ static inline void DecodeBytes_RGBA8(u32* dst, const u16* src, const u16* src2)
     dst[x] = ((src[x] & 0xFF) << 24) | ((src[x] & 0xFF00) >> 8) | (src2[x] << 8);
 }
 
+#ifndef NO_SIMD
+// [emubench] The decoders below work on 128-bit vectors through these few operations, which both
+// SSE2 and NEON have. Their results are identical to the scalar functions above.
+
+#if defined(USE_SSE)
+typedef __m128i Vector;
+
+DOLPHIN_FORCE_INLINE static Vector Load64(const void* src)
+{
+  return _mm_loadl_epi64(static_cast<const __m128i*>(src));
+}
+DOLPHIN_FORCE_INLINE static Vector Load128(const void* src)
+{
+  return _mm_loadu_si128(static_cast<const __m128i*>(src));
+}
+DOLPHIN_FORCE_INLINE static void Store128(void* dst, Vector v)
+{
+  _mm_storeu_si128(static_cast<__m128i*>(dst), v);
+}
+DOLPHIN_FORCE_INLINE static Vector Set16(u16 value)
+{
+  return _mm_set1_epi16(static_cast<s16>(value));
+}
+DOLPHIN_FORCE_INLINE static Vector And(Vector a, Vector b)
+{
+  return _mm_and_si128(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Or(Vector a, Vector b)
+{
+  return _mm_or_si128(a, b);
+}
+// Bits of a where mask is set, bits of b elsewhere
+DOLPHIN_FORCE_INLINE static Vector Select(Vector mask, Vector a, Vector b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+// Interleave the bytes or 16-bit lanes of the low or high halves of a and b
+DOLPHIN_FORCE_INLINE static Vector ZipLo8(Vector a, Vector b)
+{
+  return _mm_unpacklo_epi8(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector ZipHi8(Vector a, Vector b)
+{
+  return _mm_unpackhi_epi8(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector ZipLo16(Vector a, Vector b)
+{
+  return _mm_unpacklo_epi16(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector ZipHi16(Vector a, Vector b)
+{
+  return _mm_unpackhi_epi16(a, b);
+}
+template <int n>
+DOLPHIN_FORCE_INLINE static Vector ShiftLeft16(Vector v)
+{
+  return _mm_slli_epi16(v, n);
+}
+template <int n>
+DOLPHIN_FORCE_INLINE static Vector ShiftRight16(Vector v)
+{
+  return _mm_srli_epi16(v, n);
+}
+// All ones in the 16-bit lanes that have their top bit set
+DOLPHIN_FORCE_INLINE static Vector SignMask16(Vector v)
+{
+  return _mm_srai_epi16(v, 15);
+}
+DOLPHIN_FORCE_INLINE static Vector ByteSwap16(Vector v)
+{
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+#elif defined(USE_NEON)
+typedef uint8x16_t Vector;
+
+DOLPHIN_FORCE_INLINE static Vector Load64(const void* src)
+{
+  return vcombine_u8(vld1_u8(static_cast<const u8*>(src)), vdup_n_u8(0));
+}
+DOLPHIN_FORCE_INLINE static Vector Load128(const void* src)
+{
+  return vld1q_u8(static_cast<const u8*>(src));
+}
+DOLPHIN_FORCE_INLINE static void Store128(void* dst, Vector v)
+{
+  vst1q_u8(static_cast<u8*>(dst), v);
+}
+DOLPHIN_FORCE_INLINE static Vector Set16(u16 value)
+{
+  return vreinterpretq_u8_u16(vdupq_n_u16(value));
+}
+DOLPHIN_FORCE_INLINE static Vector And(Vector a, Vector b)
+{
+  return vandq_u8(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector Or(Vector a, Vector b)
+{
+  return vorrq_u8(a, b);
+}
+// Bits of a where mask is set, bits of b elsewhere
+DOLPHIN_FORCE_INLINE static Vector Select(Vector mask, Vector a, Vector b)
+{
+  return vbslq_u8(mask, a, b);
+}
+// Interleave the bytes or 16-bit lanes of the low or high halves of a and b
+DOLPHIN_FORCE_INLINE static Vector ZipLo8(Vector a, Vector b)
+{
+  return vzip1q_u8(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector ZipHi8(Vector a, Vector b)
+{
+  return vzip2q_u8(a, b);
+}
+DOLPHIN_FORCE_INLINE static Vector ZipLo16(Vector a, Vector b)
+{
+  return vreinterpretq_u8_u16(vzip1q_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+DOLPHIN_FORCE_INLINE static Vector ZipHi16(Vector a, Vector b)
+{
+  return vreinterpretq_u8_u16(vzip2q_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+template <int n>
+DOLPHIN_FORCE_INLINE static Vector ShiftLeft16(Vector v)
+{
+  return vreinterpretq_u8_u16(vshlq_n_u16(vreinterpretq_u16_u8(v), n));
+}
+template <int n>
+DOLPHIN_FORCE_INLINE static Vector ShiftRight16(Vector v)
+{
+  return vreinterpretq_u8_u16(vshrq_n_u16(vreinterpretq_u16_u8(v), n));
+}
+// All ones in the 16-bit lanes that have their top bit set
+DOLPHIN_FORCE_INLINE static Vector SignMask16(Vector v)
+{
+  return vreinterpretq_u8_s16(vshrq_n_s16(vreinterpretq_s16_u8(v), 15));
+}
+DOLPHIN_FORCE_INLINE static Vector ByteSwap16(Vector v)
+{
+  return vrev16q_u8(v);
+}
+#endif
+
+// Eight texels, as two vectors of four RGBA8 texels
+struct VectorPair
+{
+  Vector lo;
+  Vector hi;
+};
+
+// Same bit swizzles as LookUpTables.h, on 16-bit lanes holding values that fit their bit count
+DOLPHIN_FORCE_INLINE static Vector Convert3To8(Vector v)
+{
+  return Or(Or(ShiftLeft16<5>(v), ShiftLeft16<2>(v)), ShiftRight16<1>(v));
+}
+DOLPHIN_FORCE_INLINE static Vector Convert4To8(Vector v)
+{
+  return Or(ShiftLeft16<4>(v), v);
+}
+DOLPHIN_FORCE_INLINE static Vector Convert5To8(Vector v)
+{
+  return Or(ShiftLeft16<3>(v), ShiftRight16<2>(v));
+}
+DOLPHIN_FORCE_INLINE static Vector Convert6To8(Vector v)
+{
+  return Or(ShiftLeft16<2>(v), ShiftRight16<4>(v));
+}
+
+// Decoders of eight 16-bit texels, as read from memory
+DOLPHIN_FORCE_INLINE static VectorPair DecodeVector_IA8(Vector raw)
+{
+  // Texels are stored as AI, and turned into IIIA
+  const Vector ii = Or(ShiftRight16<8>(raw), And(raw, Set16(0xFF00)));
+  const Vector ia = ByteSwap16(raw);
+  return {ZipLo16(ii, ia), ZipHi16(ii, ia)};
+}
+
+DOLPHIN_FORCE_INLINE static VectorPair DecodeVector_RGB565(Vector raw)
+{
+  const Vector val = ByteSwap16(raw);
+  const Vector r = Convert5To8(ShiftRight16<11>(val));
+  const Vector g = Convert6To8(And(ShiftRight16<5>(val), Set16(0x3F)));
+  const Vector b = Convert5To8(And(val, Set16(0x1F)));
+  const Vector rg = Or(r, ShiftLeft16<8>(g));
+  const Vector ba = Or(b, Set16(0xFF00));
+  return {ZipLo16(rg, ba), ZipHi16(rg, ba)};
+}
+
+DOLPHIN_FORCE_INLINE static VectorPair DecodeVector_RGB5A3(Vector raw)
+{
+  const Vector val = ByteSwap16(raw);
+  const Vector opaque = SignMask16(val);
+
+  const Vector r1 = Convert5To8(And(ShiftRight16<10>(val), Set16(0x1F)));
+  const Vector g1 = Convert5To8(And(ShiftRight16<5>(val), Set16(0x1F)));
+  const Vector b1 = Convert5To8(And(val, Set16(0x1F)));
+
+  const Vector a2 = Convert3To8(And(ShiftRight16<12>(val), Set16(0x7)));
+  const Vector r2 = Convert4To8(And(ShiftRight16<8>(val), Set16(0xF)));
+  const Vector g2 = Convert4To8(And(ShiftRight16<4>(val), Set16(0xF)));
+  const Vector b2 = Convert4To8(And(val, Set16(0xF)));
+
+  const Vector rg = Select(opaque, Or(r1, ShiftLeft16<8>(g1)), Or(r2, ShiftLeft16<8>(g2)));
+  const Vector ba = Select(opaque, Or(b1, Set16(0xFF00)), Or(b2, ShiftLeft16<8>(a2)));
+  return {ZipLo16(rg, ba), ZipHi16(rg, ba)};
+}
+
+template <TLUTFormat tlutfmt>
+DOLPHIN_FORCE_INLINE static VectorPair DecodeVector_Paletted(Vector raw)
+{
+  if constexpr (tlutfmt == TLUTFormat::IA8)
+    return DecodeVector_IA8(raw);
+  else if constexpr (tlutfmt == TLUTFormat::RGB565)
+    return DecodeVector_RGB565(raw);
+  else
+    return DecodeVector_RGB5A3(raw);
+}
+
+// Two rows of four texels, which are next to each other in a 4x4 block of 16-bit texels
+DOLPHIN_FORCE_INLINE static void StoreRows4(u32* dst, int width, VectorPair texels)
+{
+  Store128(dst, texels.lo);
+  Store128(dst + width, texels.hi);
+}
+
+// One row of eight texels
+DOLPHIN_FORCE_INLINE static void StoreRow8(u32* dst, VectorPair texels)
+{
+  Store128(dst, texels.lo);
+  Store128(dst + 4, texels.hi);
+}
+
+// Repeats each byte of the low or high half of v in all the channels of a texel
+DOLPHIN_FORCE_INLINE static VectorPair Broadcast8(Vector v, bool high)
+{
+  const Vector pairs = high ? ZipHi8(v, v) : ZipLo8(v, v);
+  return {ZipLo16(pairs, pairs), ZipHi16(pairs, pairs)};
+}
+
+static void DecodeBlock_I4(u32* dst, const u8* src, int width)
+{
+  // Two rows of eight texels at a time, high nibble first
+  for (int iy = 0; iy < 8; iy += 2, src += 8, dst += 2 * width)
+  {
+    const Vector val = Load64(src);
+    const Vector high = And(ShiftRight16<4>(val), Set16(0x0F0F));
+    const Vector low = And(val, Set16(0x0F0F));
+    const Vector i = Convert4To8(ZipLo8(high, low));
+    StoreRow8(dst, Broadcast8(i, false));
+    StoreRow8(dst + width, Broadcast8(i, true));
+  }
+}
+
+static void DecodeBlock_I8(u32* dst, const u8* src, int width)
+{
+  for (int iy = 0; iy < 4; iy += 2, src += 16, dst += 2 * width)
+  {
+    const Vector i = Load128(src);
+    StoreRow8(dst, Broadcast8(i, false));
+    StoreRow8(dst + width, Broadcast8(i, true));
+  }
+}
+
+static void DecodeBlock_IA4(u32* dst, const u8* src, int width)
+{
+  for (int iy = 0; iy < 4; iy += 2, src += 16, dst += 2 * width)
+  {
+    const Vector val = Load128(src);
+    const Vector l = Or(And(ShiftLeft16<4>(val), Set16(0xF0F0)), And(val, Set16(0x0F0F)));
+    const Vector a = Or(And(val, Set16(0xF0F0)), And(ShiftRight16<4>(val), Set16(0x0F0F)));
+    for (int row = 0; row < 2; row++)
+    {
+      const Vector ll = row ? ZipHi8(l, l) : ZipLo8(l, l);
+      const Vector la = row ? ZipHi8(l, a) : ZipLo8(l, a);
+      StoreRow8(dst + row * width, {ZipLo16(ll, la), ZipHi16(ll, la)});
+    }
+  }
+}
+
+template <VectorPair (*decode)(Vector)>
+static void DecodeBlock_16Bit(u32* dst, const u8* src, int width)
+{
+  StoreRows4(dst, width, decode(Load128(src)));
+  StoreRows4(dst + 2 * width, width, decode(Load128(src + 16)));
+}
+
+// SSE2 and NEON can't gather from the TLUT, so the entries are looked up one by one and then
+// converted eight at a time.
+template <TLUTFormat tlutfmt>
+static void DecodeBlock_C4(u32* dst, const u8* src, int width, const u16* tlut)
+{
+  alignas(16) u16 entries[8];
+  for (int iy = 0; iy < 8; iy++, src += 4, dst += width)
+  {
+    for (int x = 0; x < 4; x++)
+    {
+      entries[2 * x] = tlut[src[x] >> 4];
+      entries[2 * x + 1] = tlut[src[x] & 0xF];
+    }
+    StoreRow8(dst, DecodeVector_Paletted<tlutfmt>(Load128(entries)));
+  }
+}
+
+template <TLUTFormat tlutfmt>
+static void DecodeBlock_C8(u32* dst, const u8* src, int width, const u16* tlut)
+{
+  alignas(16) u16 entries[8];
+  for (int iy = 0; iy < 4; iy++, src += 8, dst += width)
+  {
+    for (int x = 0; x < 8; x++)
+      entries[x] = tlut[src[x]];
+    StoreRow8(dst, DecodeVector_Paletted<tlutfmt>(Load128(entries)));
+  }
+}
+
+template <TLUTFormat tlutfmt>
+static void DecodeBlock_C14X2(u32* dst, const u8* src, int width, const u16* tlut)
+{
+  alignas(16) u16 entries[8];
+  for (int iy = 0; iy < 4; iy += 2, src += 16, dst += 2 * width)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      u16 val;
+      std::memcpy(&val, src + 2 * x, sizeof(u16));
+      entries[x] = tlut[Common::swap16(val) & 0x3FFF];
+    }
+    StoreRows4(dst, width, DecodeVector_Paletted<tlutfmt>(Load128(entries)));
+  }
+}
+
+template <TextureFormat texformat, TLUTFormat tlutfmt>
+static void DecodePalettedTexture(u32* dst, const u8* src, int width, int height, const u16* tlut)
+{
+  const int block_width = texformat == TextureFormat::C14X2 ? 4 : 8;
+  const int block_height = texformat == TextureFormat::C4 ? 8 : 4;
+
+  for (int y = 0; y < height; y += block_height)
+  {
+    for (int x = 0; x < width; x += block_width, src += 32)
+    {
+      if constexpr (texformat == TextureFormat::C4)
+        DecodeBlock_C4<tlutfmt>(dst + y * width + x, src, width, tlut);
+      else if constexpr (texformat == TextureFormat::C8)
+        DecodeBlock_C8<tlutfmt>(dst + y * width + x, src, width, tlut);
+      else
+        DecodeBlock_C14X2<tlutfmt>(dst + y * width + x, src, width, tlut);
+    }
+  }
+}
+
+// Returns false for invalid TLUT formats, which are left to the scalar code
+template <TextureFormat texformat>
+static bool DecodePalettedTexture(u32* dst, const u8* src, int width, int height, const u8* tlut,
+                                  TLUTFormat tlutfmt)
+{
+  const u16* tlut16 = reinterpret_cast<const u16*>(tlut);
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+    DecodePalettedTexture<texformat, TLUTFormat::IA8>(dst, src, width, height, tlut16);
+    return true;
+  case TLUTFormat::RGB565:
+    DecodePalettedTexture<texformat, TLUTFormat::RGB565>(dst, src, width, height, tlut16);
+    return true;
+  case TLUTFormat::RGB5A3:
+    DecodePalettedTexture<texformat, TLUTFormat::RGB5A3>(dst, src, width, height, tlut16);
+    return true;
+  default:
+    return false;
+  }
+}
+
+// For each value of a CMPR line byte, the bytes of its four texels' colors in a vector of colors
+static constexpr auto s_cmpr_row_shuffles = [] {
+  std::array<std::array<u8, 16>, 256> shuffles{};
+  for (int val = 0; val < 256; val++)
+  {
+    for (int x = 0; x < 4; x++)
+    {
+      const int color = (val >> (6 - 2 * x)) & 3;
+      for (int byte = 0; byte < 4; byte++)
+        shuffles[val][4 * x + byte] = static_cast<u8>(4 * color + byte);
+    }
+  }
+  return shuffles;
+}();
+
+// One row of a DXT block: the four texels that the indices in val pick from colors
+DOLPHIN_FORCE_INLINE static Vector SelectDXTColors(Vector colors, u8 val)
+{
+  const Vector shuffle = Load128(s_cmpr_row_shuffles[val].data());
+#if defined(USE_NEON)
+  return vqtbl1q_u8(colors, shuffle);
+#else
+  // SSE2 has no byte shuffle, so each texel is compared against the four colors instead
+  const auto pick = [shuffle](int color, Vector broadcast) {
+    const Vector pattern = _mm_set1_epi32(0x03020100 + color * 0x04040404);
+    return And(_mm_cmpeq_epi32(shuffle, pattern), broadcast);
+  };
+  return Or(Or(pick(0, _mm_shuffle_epi32(colors, 0x00)), pick(1, _mm_shuffle_epi32(colors, 0x55))),
+            Or(pick(2, _mm_shuffle_epi32(colors, 0xAA)), pick(3, _mm_shuffle_epi32(colors, 0xFF))));
+#endif
+}
+#endif  // NO_SIMD
+
 static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 {
   // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
@@ -155,6 +575,11 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
   }
 
+#ifndef NO_SIMD
+  const Vector color_vector = Load128(colors);
+  for (int y = 0; y < 4; y++, dst += pitch)
+    Store128(dst, SelectDXTColors(color_vector, src->lines[y]));
+#else
   for (int y = 0; y < 4; y++)
   {
     int val = src->lines[y];
@@ -165,6 +590,7 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     }
     dst += pitch;
   }
+#endif
 }
 
 // JSD 01/06/11:
@@ -187,6 +613,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
+#ifndef NO_SIMD
+    if (DecodePalettedTexture<TextureFormat::C4>(dst, src, width, height, tlut, tlutfmt))
+      break;
+#endif
     for (int y = 0; y < height; y += 8)
       for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
@@ -194,6 +624,11 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   case TextureFormat::I4:
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 8)
+      for (int x = 0; x < width; x += 8, src += 32)
+        DecodeBlock_I4(dst + y * width + x, src, width);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 8)
       for (int x = 0; x < width; x += 8)
@@ -206,10 +641,16 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
             memset(dst + (y + iy) * width + x + ix * 2, i1, 4);
             memset(dst + (y + iy) * width + x + ix * 2 + 1, i2, 4);
           }
+#endif
   }
   break;
   case TextureFormat::I8:  // speed critical
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8, src += 32)
+        DecodeBlock_I8(dst + y * width + x, src, width);
+#else
     // Reference C implementation
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 8)
@@ -236,9 +677,14 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           srcval = newsrc[0];
           newdst[0] = srcval | (srcval << 8) | (srcval << 16) | (srcval << 24);
         }
+#endif
   }
   break;
   case TextureFormat::C8:
+#ifndef NO_SIMD
+    if (DecodePalettedTexture<TextureFormat::C8>(dst, src, width, height, tlut, tlutfmt))
+      break;
+#endif
     for (int y = 0; y < height; y += 4)
       for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
@@ -246,14 +692,25 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   case TextureFormat::IA4:
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8, src += 32)
+        DecodeBlock_IA4(dst + y * width + x, src, width);
+#else
     for (int y = 0; y < height; y += 4)
       for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
           DecodeBytes_IA4(dst + (y + iy) * width + x, src + 8 * xStep);
+#endif
   }
   break;
   case TextureFormat::IA8:
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4, src += 32)
+        DecodeBlock_16Bit<DecodeVector_IA8>(dst + y * width + x, src, width);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
@@ -266,9 +723,14 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           ptr[2] = DecodePixel_IA8(s[2]);
           ptr[3] = DecodePixel_IA8(s[3]);
         }
+#endif
   }
   break;
   case TextureFormat::C14X2:
+#ifndef NO_SIMD
+    if (DecodePalettedTexture<TextureFormat::C14X2>(dst, src, width, height, tlut, tlutfmt))
+      break;
+#endif
     for (int y = 0; y < height; y += 4)
       for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
         for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
@@ -276,6 +738,11 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   case TextureFormat::RGB565:
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4, src += 32)
+        DecodeBlock_16Bit<DecodeVector_RGB565>(dst + y * width + x, src, width);
+#else
     // Reference C implementation.
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
@@ -286,15 +753,22 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           for (int j = 0; j < 4; j++)
             *ptr++ = DecodePixel_RGB565(Common::swap16(*s++));
         }
+#endif
   }
   break;
   case TextureFormat::RGB5A3:
   {
+#ifndef NO_SIMD
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4, src += 32)
+        DecodeBlock_16Bit<DecodeVector_RGB5A3>(dst + y * width + x, src, width);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
         for (int iy = 0; iy < 4; iy++, src += 8)
           DecodeBytes_RGB5A3(dst + (y + iy) * width + x, (u16*)src);
+#endif
   }
   break;
   case TextureFormat::RGBA8:  // speed critical
@@ -21,6 +21,7 @@
 
 #include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderSpecialized.h"
 #include "VideoCommon/VertexLoader_Color.h"
 #include "VideoCommon/VertexLoader_Normal.h"
 #include "VideoCommon/VertexLoader_Position.h"
@@ -252,12 +253,14 @@ std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVt
   native_loader = std::make_unique<VertexLoaderX64>(vtx_desc, vtx_attr);
 #elif defined(_M_ARM_64)
   native_loader = std::make_unique<VertexLoaderARM64>(vtx_desc, vtx_attr);
+#else
+  // [emubench] Without a JIT, common layouts still get a loader compiled for them
+  native_loader = VertexLoaderSpecialized::Create(vtx_desc, vtx_attr);
 #endif
 
   // Use the software loader as a fallback
-  // (not currently applicable, as both VertexLoaderX64 and VertexLoaderARM64
-  // are always usable, but if a loader that only works on some CPUs is created
-  // then this fallback would be used)
+  // (VertexLoaderX64 and VertexLoaderARM64 are always usable, but the specialized loaders of
+  // other architectures only cover some layouts)
   if (!native_loader)
   {
     return std::make_unique<VertexLoader>(vtx_desc, vtx_attr);
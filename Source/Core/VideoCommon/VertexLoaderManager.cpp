@@ -27,6 +27,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/RenderSkip.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -408,6 +409,10 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     // Doing early return for the opposite case would be cleaner
     // but triggers a false unreachable code warning in MSVC debug builds.
 
+    // [emubench] Frames nobody observes only need the state changes around their primitives
+    if (g_render_skip.IsSkippingDraws())
+      return size;
+
     if (g_needs_cp_xf_consistency_check) [[unlikely]]
     {
       CheckCPConfiguration(vtx_attr_group);
@@ -0,0 +1,501 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/VertexLoaderSpecialized.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/Inline.h"
+#include "Common/Swap.h"
+
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderUtils.h"
+
+namespace
+{
+using VCF = VertexComponentFormat;
+using FMT = ComponentFormat;
+
+// Everything about a vertex layout that changes the generated code. The scales are read from the
+// loader at run time, like VertexLoader does. Colors are always RGBA8888, and the formats of
+// components that are not present are left at zero so that equal layouts compare equal.
+struct Layout
+{
+  bool posmtx = false;
+  VCF position = VCF::NotPresent;
+  FMT position_format = FMT::UByte;
+  CoordComponentCount position_elements = CoordComponentCount::XY;
+  VCF normal = VCF::NotPresent;
+  FMT normal_format = FMT::UByte;
+  std::array<VCF, 2> color{};
+  std::array<VCF, 2> texcoord{};
+  std::array<FMT, 2> texcoord_format{};
+  std::array<TexComponentCount, 2> texcoord_elements{};
+
+  constexpr bool operator==(const Layout&) const = default;
+};
+
+constexpr auto XYZ = CoordComponentCount::XYZ;
+constexpr auto ST = TexComponentCount::ST;
+
+// Indexed layouts are what most 3D geometry uses, direct ones are typical for 2D and UI drawing.
+constexpr std::array s_layouts = {
+    Layout{.position = VCF::Index16, .position_format = FMT::Float, .position_elements = XYZ},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Float},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Float,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Short,
+           .texcoord = {VCF::Index16, VCF::Index16},
+           .texcoord_format = {FMT::UShort, FMT::Float},
+           .texcoord_elements = {ST, ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .color = {VCF::Index16}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .color = {VCF::Index16},
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Float,
+           .color = {VCF::Index16},
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Short,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Byte,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Short},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Index16,
+           .position_format = FMT::Short,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Short,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Short},
+           .texcoord_elements = {ST}},
+    Layout{.posmtx = true,
+           .position = VCF::Index16,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Float,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.posmtx = true,
+           .position = VCF::Index16,
+           .position_format = FMT::Short,
+           .position_elements = XYZ,
+           .normal = VCF::Index16,
+           .normal_format = FMT::Byte,
+           .texcoord = {VCF::Index16},
+           .texcoord_format = {FMT::Short},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .color = {VCF::Direct}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .color = {VCF::Direct},
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = CoordComponentCount::XY,
+           .color = {VCF::Direct},
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Short,
+           .position_elements = XYZ,
+           .color = {VCF::Direct},
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Short},
+           .texcoord_elements = {ST}},
+    Layout{.position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .normal = VCF::Direct,
+           .normal_format = FMT::Float,
+           .color = {VCF::Direct},
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+    Layout{.posmtx = true,
+           .position = VCF::Direct,
+           .position_format = FMT::Float,
+           .position_elements = XYZ,
+           .color = {VCF::Direct},
+           .texcoord = {VCF::Direct},
+           .texcoord_format = {FMT::Float},
+           .texcoord_elements = {ST}},
+};
+
+template <FMT format>
+using ComponentType =
+    std::tuple_element_t<static_cast<size_t>(format), std::tuple<u8, s8, u16, s16, float>>;
+
+template <VCF type>
+using IndexType = std::conditional_t<type == VCF::Index8, u8, u16>;
+
+// The array of an indexed component, loaded once per call instead of once per vertex
+struct ArrayPointer
+{
+  const u8* base;
+  u32 stride;
+};
+
+ArrayPointer GetArray(CPArray array)
+{
+  return {VertexLoaderManager::cached_arraybases[array], g_main_cp_state.array_strides[array]};
+}
+
+template <VCF type>
+DOLPHIN_FORCE_INLINE const u8* ReadIndex(const u8*& src, const ArrayPointer& array)
+{
+  return array.base + DataRead<IndexType<type>>(&src) * array.stride;
+}
+
+template <typename T>
+DOLPHIN_FORCE_INLINE void Write(u8*& dst, T value)
+{
+  std::memcpy(dst, &value, sizeof(T));
+  dst += sizeof(T);
+}
+
+// Same arithmetic as PosScale and TCScale
+template <typename T>
+DOLPHIN_FORCE_INLINE float Dequantize(T value, float scale)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return value;
+  else
+    return value * scale;
+}
+
+// Same arithmetic as the FracAdjust of VertexLoader_Normal
+template <typename T>
+DOLPHIN_FORCE_INLINE float NormalFrac(T value)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return value;
+  else
+    return value / float(1u << (sizeof(T) * 8 - std::is_signed_v<T> - 1));
+}
+
+// Returns whether the vertex has to be skipped
+template <Layout L>
+DOLPHIN_FORCE_INLINE bool ReadPosition(const u8*& src, u8*& dst, const ArrayPointer& array,
+                                       float scale, int remaining)
+{
+  using T = ComponentType<L.position_format>;
+  constexpr int N = L.position_elements == CoordComponentCount::XY ? 2 : 3;
+
+  if constexpr (IsIndexed(L.position))
+  {
+    using I = IndexType<L.position>;
+    const I index = DataRead<I>(&src);
+    const bool skip = index == std::numeric_limits<I>::max();
+    const auto data = reinterpret_cast<const T*>(array.base + index * array.stride);
+    for (int i = 0; i < N; i++)
+    {
+      const float value = Dequantize(Common::FromBigEndian(data[i]), scale);
+      if (remaining < 3 && !skip)
+        VertexLoaderManager::position_cache[remaining][i] = value;
+      Write(dst, value);
+    }
+    return skip;
+  }
+  else
+  {
+    for (int i = 0; i < N; i++)
+    {
+      const float value = Dequantize(DataRead<T>(&src), scale);
+      if (remaining < 3)
+        VertexLoaderManager::position_cache[remaining][i] = value;
+      Write(dst, value);
+    }
+    return false;
+  }
+}
+
+template <Layout L>
+DOLPHIN_FORCE_INLINE void ReadNormal(const u8*& src, u8*& dst, const ArrayPointer& array,
+                                     int remaining)
+{
+  using T = ComponentType<L.normal_format>;
+
+  const T* data;
+  if constexpr (IsIndexed(L.normal))
+  {
+    data = reinterpret_cast<const T*>(ReadIndex<L.normal>(src, array));
+  }
+  else
+  {
+    data = reinterpret_cast<const T*>(src);
+    src += 3 * sizeof(T);
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    const float value = NormalFrac(Common::FromBigEndian(data[i]));
+    if (remaining == 0)
+      VertexLoaderManager::normal_cache[i] = value;
+    Write(dst, value);
+  }
+}
+
+// RGBA8888 is stored in the order the native vertex format expects, so it is copied unswapped
+template <VCF type>
+DOLPHIN_FORCE_INLINE void ReadColor(const u8*& src, u8*& dst, const ArrayPointer& array)
+{
+  if constexpr (type != VCF::NotPresent)
+  {
+    const u8* address;
+    if constexpr (IsIndexed(type))
+    {
+      address = ReadIndex<type>(src, array);
+    }
+    else
+    {
+      address = src;
+      src += sizeof(u32);
+    }
+
+    u32 value;
+    std::memcpy(&value, address, sizeof(u32));
+    Write(dst, value);
+  }
+}
+
+template <VCF type, FMT format, TexComponentCount elements>
+DOLPHIN_FORCE_INLINE void ReadTexCoord(const u8*& src, u8*& dst, const ArrayPointer& array,
+                                       float scale)
+{
+  using T = ComponentType<format>;
+  constexpr int N = elements == TexComponentCount::ST ? 2 : 1;
+
+  if constexpr (IsIndexed(type))
+  {
+    const auto data = reinterpret_cast<const T*>(ReadIndex<type>(src, array));
+    for (int i = 0; i < N; i++)
+      Write(dst, Dequantize(Common::FromBigEndian(data[i]), scale));
+  }
+  else if constexpr (type == VCF::Direct)
+  {
+    for (int i = 0; i < N; i++)
+      Write(dst, Dequantize(DataRead<T>(&src), scale));
+  }
+}
+
+// VertexLoader is only used for its native vertex declaration and its scales, its pipeline is
+// replaced by code generated for one layout.
+template <Layout L>
+class SpecializedVertexLoader final : public VertexLoader
+{
+public:
+  using VertexLoader::VertexLoader;
+
+  int RunVertices(const u8* src, u8* dst, int count) override
+  {
+    const ArrayPointer position_array = GetArray(CPArray::Position);
+    const ArrayPointer normal_array = GetArray(CPArray::Normal);
+    const std::array<ArrayPointer, 2> color_arrays = {GetArray(CPArray::Color0),
+                                                      GetArray(CPArray::Color1)};
+    const std::array<ArrayPointer, 2> texcoord_arrays = {GetArray(CPArray::TexCoord0),
+                                                         GetArray(CPArray::TexCoord1)};
+    const u32 stride = m_native_vtx_decl.stride;
+
+    m_numLoadedVertices += count;
+    int skipped_vertices = 0;
+
+    for (int remaining = count - 1; remaining >= 0; remaining--)
+    {
+      if constexpr (L.posmtx)
+      {
+        const u32 posmtx = DataRead<u8>(&src) & 0x3f;
+        if (remaining < 3)
+          VertexLoaderManager::position_matrix_index_cache[remaining] = posmtx;
+        Write(dst, posmtx);
+      }
+
+      const bool skip = ReadPosition<L>(src, dst, position_array, m_posScale, remaining);
+
+      if constexpr (L.normal != VCF::NotPresent)
+        ReadNormal<L>(src, dst, normal_array, remaining);
+
+      ReadColor<L.color[0]>(src, dst, color_arrays[0]);
+      ReadColor<L.color[1]>(src, dst, color_arrays[1]);
+
+      ReadTexCoord<L.texcoord[0], L.texcoord_format[0], L.texcoord_elements[0]>(
+          src, dst, texcoord_arrays[0], m_tcScale[0]);
+      ReadTexCoord<L.texcoord[1], L.texcoord_format[1], L.texcoord_elements[1]>(
+          src, dst, texcoord_arrays[1], m_tcScale[1]);
+
+      if (skip)
+      {
+        dst -= stride;
+        skipped_vertices++;
+      }
+    }
+
+    return count - skipped_vertices;
+  }
+};
+
+using Factory = std::unique_ptr<VertexLoaderBase> (*)(const TVtxDesc&, const VAT&);
+
+template <Layout L>
+std::unique_ptr<VertexLoaderBase> CreateLoader(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
+{
+  return std::make_unique<SpecializedVertexLoader<L>>(vtx_desc, vtx_attr);
+}
+
+template <size_t... Is>
+constexpr std::array<Factory, sizeof...(Is)> MakeFactories(std::index_sequence<Is...>)
+{
+  return {CreateLoader<s_layouts[Is]>...};
+}
+
+constexpr auto s_factories = MakeFactories(std::make_index_sequence<s_layouts.size()>());
+
+bool GetLayout(const TVtxDesc& vtx_desc, const VAT& vtx_attr, Layout* layout)
+{
+  for (bool texmtx : vtx_desc.low.TexMatIdx)
+  {
+    if (texmtx)
+      return false;
+  }
+  for (size_t i = layout->texcoord.size(); i < vtx_desc.high.TexCoord.Size(); i++)
+  {
+    if (vtx_desc.high.TexCoord[i] != VCF::NotPresent)
+      return false;
+  }
+
+  layout->posmtx = vtx_desc.low.PosMatIdx;
+  layout->position = vtx_desc.low.Position;
+  layout->position_format = vtx_attr.g0.PosFormat;
+  layout->position_elements = vtx_attr.g0.PosElements;
+
+  layout->normal = vtx_desc.low.Normal;
+  if (layout->normal != VCF::NotPresent)
+  {
+    if (vtx_attr.g0.NormalElements != NormalComponentCount::N)
+      return false;
+    layout->normal_format = vtx_attr.g0.NormalFormat;
+  }
+
+  for (size_t i = 0; i < layout->color.size(); i++)
+  {
+    layout->color[i] = vtx_desc.low.Color[i];
+    if (layout->color[i] != VCF::NotPresent && vtx_attr.GetColorFormat(i) != ColorFormat::RGBA8888)
+      return false;
+  }
+
+  for (size_t i = 0; i < layout->texcoord.size(); i++)
+  {
+    layout->texcoord[i] = vtx_desc.high.TexCoord[i];
+    if (layout->texcoord[i] != VCF::NotPresent)
+    {
+      layout->texcoord_format[i] = vtx_attr.GetTexFormat(i);
+      layout->texcoord_elements[i] = vtx_attr.GetTexElements(i);
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+std::unique_ptr<VertexLoaderBase> VertexLoaderSpecialized::Create(const TVtxDesc& vtx_desc,
+                                                                  const VAT& vtx_attr)
+{
+  Layout layout;
+  if (!GetLayout(vtx_desc, vtx_attr, &layout))
+    return nullptr;
+
+  for (size_t i = 0; i < s_layouts.size(); i++)
+  {
+    if (s_layouts[i] == layout)
+      return s_factories[i](vtx_desc, vtx_attr);
+  }
+  return nullptr;
+}
+
+std::vector<std::pair<TVtxDesc, VAT>> VertexLoaderSpecialized::GetSupportedFormats()
+{
+  std::vector<std::pair<TVtxDesc, VAT>> formats;
+  for (const Layout& layout : s_layouts)
+  {
+    TVtxDesc vtx_desc;
+    VAT vtx_attr;
+
+    vtx_desc.low.PosMatIdx = layout.posmtx;
+    vtx_desc.low.Position = layout.position;
+    vtx_attr.g0.PosFormat = layout.position_format;
+    vtx_attr.g0.PosElements = layout.position_elements;
+    vtx_desc.low.Normal = layout.normal;
+    vtx_attr.g0.NormalFormat = layout.normal_format;
+    vtx_desc.low.Color[0] = layout.color[0];
+    vtx_desc.low.Color[1] = layout.color[1];
+    vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+    vtx_attr.g0.Color1Comp = ColorFormat::RGBA8888;
+    for (size_t i = 0; i < layout.texcoord.size(); i++)
+    {
+      vtx_desc.high.TexCoord[i] = layout.texcoord[i];
+      vtx_attr.SetTexFormat(i, layout.texcoord_format[i]);
+      vtx_attr.SetTexElements(i, layout.texcoord_elements[i]);
+    }
+
+    formats.emplace_back(vtx_desc, vtx_attr);
+  }
+  return formats;
+}
@@ -0,0 +1,23 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/VertexLoaderBase.h"
+
+// [emubench] Vertex loaders compiled ahead of time for the most common vertex layouts, for builds
+// without a JIT vertex loader. Their output is identical to VertexLoader's.
+class VertexLoaderSpecialized
+{
+public:
+  // Returns nullptr if there is no specialized loader for this layout
+  static std::unique_ptr<VertexLoaderBase> Create(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+
+  // Every layout that has a specialized loader, for testing
+  static std::vector<std::pair<TVtxDesc, VAT>> GetSupportedFormats();
+};
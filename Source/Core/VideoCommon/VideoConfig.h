@@ -288,6 +288,7 @@ struct VideoConfig final
   bool bDeferEFBCopies = false;
   bool bImmediateXFB = false;
   bool bSkipPresentingDuplicateXFBs = false;
+  bool bSkipUnobservedFrames = false;  // [emubench]
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
@@ -341,6 +342,10 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // [emubench] Number of threads decoding large textures on the CPU, including the video thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecodeThreads = 0;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -389,6 +394,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecodeThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
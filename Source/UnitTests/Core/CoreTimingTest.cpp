@@ -3,9 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -401,3 +406,149 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+namespace TimingWheelTest
+{
+struct FiredEvent
+{
+  u64 userdata;
+  s64 lateness;
+  s64 ticks;
+
+  bool operator==(const FiredEvent&) const = default;
+};
+
+static constexpr int NUM_EVENT_TYPES = 8;
+static constexpr int NUM_ITERATIONS = 100000;
+
+static std::array<CoreTiming::EventType*, NUM_EVENT_TYPES> s_event_types;
+static std::vector<FiredEvent> s_fired;
+static u64 s_random_state = 0;
+static u64 s_next_userdata = 0;
+
+static u64 NextRandom()
+{
+  // xorshift64, so both runs see the same sequence
+  s_random_state ^= s_random_state << 13;
+  s_random_state ^= s_random_state >> 7;
+  s_random_state ^= s_random_state << 17;
+  return s_random_state;
+}
+
+// Delays are multiples of 50 so that many events share a time and rely on the FIFO tie-break
+static s64 RandomDelay()
+{
+  const u64 r = NextRandom();
+  return (r % 8 == 0) ? static_cast<s64>(r % 2000000) : static_cast<s64>(r % 40) * 50;
+}
+
+static void RescheduleCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  auto& core_timing = system.GetCoreTiming();
+  s_fired.push_back({userdata, lateness, static_cast<s64>(core_timing.GetTicks())});
+
+  // Most events are periodic, like VI or audio events rescheduling themselves
+  if (NextRandom() % 4 != 0)
+  {
+    core_timing.ScheduleEvent(RandomDelay(), s_event_types[userdata % NUM_EVENT_TYPES],
+                              s_next_userdata++ * NUM_EVENT_TYPES + userdata % NUM_EVENT_TYPES);
+  }
+}
+
+// If `elapsed` is given, it receives the time spent scheduling, cancelling and advancing
+static std::vector<FiredEvent> RunWorkload(Core::System& system, bool use_timing_wheel,
+                                           std::chrono::nanoseconds* elapsed = nullptr)
+{
+  ScopeInit guard(system);
+  EXPECT_TRUE(guard.UserDirectoryExists());
+
+  Config::SetCurrent(Config::MAIN_TIMING_WHEEL, use_timing_wheel);
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+  for (int i = 0; i < NUM_EVENT_TYPES; ++i)
+  {
+    s_event_types[i] =
+        core_timing.RegisterEvent(fmt::format("callback{}", i), RescheduleCallback);
+  }
+
+  s_fired.clear();
+  s_fired.reserve(NUM_ITERATIONS * 2);
+  s_random_state = 0x9E3779B97F4A7C15;
+  s_next_userdata = 0;
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_ITERATIONS; ++i)
+  {
+    const u64 r = NextRandom();
+    const u64 type = r % NUM_EVENT_TYPES;
+    if (r % 64 == 0)
+    {
+      core_timing.RemoveEvent(s_event_types[type]);
+    }
+    else
+    {
+      core_timing.ScheduleEvent(RandomDelay(), s_event_types[type],
+                                s_next_userdata++ * NUM_EVENT_TYPES + type);
+    }
+
+    if (i % 2 == 0)
+    {
+      ppc_state.downcount = 0;
+      core_timing.Advance();
+    }
+  }
+  if (elapsed)
+    *elapsed = std::chrono::steady_clock::now() - start;
+
+  Config::SetCurrent(Config::MAIN_TIMING_WHEEL, false);
+  return std::move(s_fired);
+}
+}  // namespace TimingWheelTest
+
+// Runs the same schedule/cancel/advance workload on the binary heap and on the timing wheel. Both
+// must fire the same events in the same order.
+TEST(CoreTiming, TimingWheelMatchesHeap)
+{
+  using namespace TimingWheelTest;
+
+  auto& system = Core::System::GetInstance();
+
+  const std::vector<FiredEvent> heap_events = RunWorkload(system, false);
+  const std::vector<FiredEvent> wheel_events = RunWorkload(system, true);
+
+  ASSERT_FALSE(heap_events.empty());
+  ASSERT_EQ(heap_events.size(), wheel_events.size());
+  for (size_t i = 0; i < heap_events.size(); ++i)
+    ASSERT_EQ(heap_events[i], wheel_events[i]) << "at event " << i;
+}
+
+// Times the workload above on both schedulers. Disabled by default; run it with
+// --gtest_also_run_disabled_tests --gtest_filter=CoreTiming.DISABLED_SchedulerBenchmark
+TEST(CoreTiming, DISABLED_SchedulerBenchmark)
+{
+  using namespace TimingWheelTest;
+
+  static constexpr int NUM_RUNS = 10;
+
+  auto& system = Core::System::GetInstance();
+
+  for (const bool use_timing_wheel : {false, true})
+  {
+    std::chrono::nanoseconds best = std::chrono::nanoseconds::max();
+    size_t fired = 0;
+    for (int run = 0; run < NUM_RUNS; ++run)
+    {
+      std::chrono::nanoseconds elapsed;
+      fired = RunWorkload(system, use_timing_wheel, &elapsed).size();
+      best = std::min(best, elapsed);
+    }
+
+    fmt::print("{}: {} iterations, {} events fired, best of {} runs: {:.3f} ms\n",
+               use_timing_wheel ? "timing wheel" : "binary heap", NUM_ITERATIONS, fired, NUM_RUNS,
+               std::chrono::duration<double, std::milli>(best).count());
+  }
+}
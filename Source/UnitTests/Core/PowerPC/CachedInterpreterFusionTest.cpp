@@ -0,0 +1,68 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/Gekko.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+UGeckoInstruction DForm(u32 opcd, u32 rd, u32 ra, u16 imm)
+{
+  return UGeckoInstruction(opcd << 26 | rd << 21 | ra << 16 | imm);
+}
+
+UGeckoInstruction Lis(u32 rd, u16 imm)
+{
+  return DForm(15, rd, 0, imm);
+}
+
+UGeckoInstruction Addi(u32 rd, u32 ra, u16 imm)
+{
+  return DForm(14, rd, ra, imm);
+}
+
+UGeckoInstruction Ori(u32 ra, u32 rs, u16 imm)
+{
+  return DForm(24, rs, ra, imm);
+}
+}  // namespace
+
+TEST(CachedInterpreterFusion, LisAddi)
+{
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8000), Addi(3, 3, 0x1234)),
+            0x80001234u);
+  // addi sign-extends its immediate
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8001), Addi(3, 3, 0x8000)),
+            0x80008000u);
+}
+
+TEST(CachedInterpreterFusion, LisAddiR0)
+{
+  // addi r0, r0, lo computes 0 + lo, not r0 + lo, so it mustn't be folded into the lis
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(0, 0x8000), Addi(0, 0, 0x1234)),
+            std::nullopt);
+}
+
+TEST(CachedInterpreterFusion, LisOri)
+{
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8001), Ori(3, 3, 0x8000)),
+            0x80018000u);
+  // ori reads r0 like any other register
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(0, 0x8000), Ori(0, 0, 0x1234)),
+            0x80001234u);
+}
+
+TEST(CachedInterpreterFusion, DifferentRegisters)
+{
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8000), Addi(4, 3, 0x1234)),
+            std::nullopt);
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8000), Addi(3, 4, 0x1234)),
+            std::nullopt);
+  EXPECT_EQ(CachedInterpreter::GetFusedLoadImmediate(Lis(3, 0x8000), Ori(4, 3, 0x1234)),
+            std::nullopt);
+}
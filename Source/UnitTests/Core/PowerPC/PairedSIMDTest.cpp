@@ -0,0 +1,121 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/Interpreter/Interpreter_PairedSIMD.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#include "TestValues.h"
+
+#ifdef PAIRED_SIMD_AVAILABLE
+
+// [emubench] The vector kernels must either decline or match the scalar helpers bit for bit
+
+TEST(PairedSIMD, ArithMatchesScalar)
+{
+  PowerPC::PowerPCState ppc_state;
+  for (const u64 a0 : double_test_values)
+  {
+    for (const u64 b0 : double_test_values)
+    {
+      const u64 a1 = b0 ^ Common::DOUBLE_SIGN;
+      const u64 b1 = a0;
+      const PowerPC::PairedSingle a{a0, a1};
+      const PowerPC::PairedSingle b{b0, b1};
+      const auto va = PairedSIMD::Load(a);
+      const auto vb = PairedSIMD::Load(b);
+
+      const auto check = [&](bool handled, auto scalar) {
+        if (!handled)
+          return;
+        const float ps0 = ForceSingle(ppc_state.fpscr, scalar(a.PS0AsDouble(), b.PS0AsDouble()));
+        const float ps1 = ForceSingle(ppc_state.fpscr, scalar(a.PS1AsDouble(), b.PS1AsDouble()));
+        EXPECT_EQ(std::bit_cast<u64>(double(ps0)), ppc_state.ps[0].ps0) << a0 << " " << b0;
+        EXPECT_EQ(std::bit_cast<u64>(double(ps1)), ppc_state.ps[0].ps1) << a1 << " " << b1;
+        EXPECT_EQ(Common::ClassifyFloat(ps0), ppc_state.fpscr.FPRF);
+      };
+
+      for (const bool non_ieee : {false, true})
+      {
+        ppc_state.fpscr.Hex = 0;
+        ppc_state.fpscr.NI = non_ieee;
+
+        check(PairedSIMD::TryArith<PairedSIMD::Arith::Add>(ppc_state, 0, va, vb),
+              [](double x, double y) { return x + y; });
+        check(PairedSIMD::TryArith<PairedSIMD::Arith::Sub>(ppc_state, 0, va, vb),
+              [](double x, double y) { return x - y; });
+        check(PairedSIMD::TryArith<PairedSIMD::Arith::Mul>(ppc_state, 0, va, vb),
+              [](double x, double y) { return x * y; });
+        check(PairedSIMD::TryArith<PairedSIMD::Arith::Div>(ppc_state, 0, va, vb),
+              [](double x, double y) { return x / y; });
+        check(PairedSIMD::TryMAdd<false, false>(ppc_state, 0, va, vb, vb),
+              [](double x, double y) { return std::fma(x, y, y); });
+        check(PairedSIMD::TryMAdd<true, true>(ppc_state, 0, va, vb, vb),
+              [&](double x, double y) {
+                return -double(ForceSingle(ppc_state.fpscr, std::fma(x, y, -y)));
+              });
+      }
+    }
+  }
+}
+
+TEST(PairedSIMD, Force25BitMatchesScalar)
+{
+  for (const u64 c0 : double_test_values)
+  {
+    for (const u64 c1 : {u64{0x3FF0'0000'0000'0000}, u64{0x0000'0000'0000'0001}})
+    {
+      const auto result = PairedSIMD::Force25BitPair({c0, c1});
+      EXPECT_EQ(std::bit_cast<u64>(Force25Bit(std::bit_cast<double>(c0))),
+                std::bit_cast<u64>(PairedSIMD::Lane0(result)));
+      EXPECT_EQ(std::bit_cast<u64>(Force25Bit(std::bit_cast<double>(c1))),
+                std::bit_cast<u64>(PairedSIMD::Lane1(result)));
+    }
+  }
+}
+
+template <typename T>
+static void CheckQuantize()
+{
+  constexpr float min = float(std::numeric_limits<T>::min());
+  constexpr float max = float(std::numeric_limits<T>::max());
+  for (const float scale : {1.0f, 256.0f, 1.0f / 65536.0f})
+  {
+    for (const u64 ps0 : double_test_values)
+    {
+      const double value = std::bit_cast<double>(ps0);
+      const auto result = PairedSIMD::Quantize(value, -value, scale, min, max);
+      if (std::isnan(value))
+      {
+        EXPECT_FALSE(result.has_value());
+        continue;
+      }
+
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(T(std::clamp(float(value) * scale, min, max)), T(result->first));
+      EXPECT_EQ(T(std::clamp(float(-value) * scale, min, max)), T(result->second));
+
+      const auto dequantized = PairedSIMD::Dequantize(T(result->first), T(result->second), scale);
+      EXPECT_EQ(double(float(T(result->first)) * scale), PairedSIMD::Lane0(dequantized));
+      EXPECT_EQ(double(float(T(result->second)) * scale), PairedSIMD::Lane1(dequantized));
+    }
+  }
+}
+
+TEST(PairedSIMD, QuantizeMatchesScalar)
+{
+  CheckQuantize<u8>();
+  CheckQuantize<s8>();
+  CheckQuantize<u16>();
+  CheckQuantize<s16>();
+}
+
+#endif
@@ -1,9 +1,12 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <bit>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -15,8 +18,10 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderSpecialized.h"
 
 TEST(VertexLoaderUID, UniqueEnough)
 {
@@ -1077,6 +1082,90 @@ TEST_P(VertexLoaderSkippedTexCoordsTest, SkippedTextures)
   }
 }
 
+// [emubench] The specialized loaders must produce exactly what the interpreted loader produces
+TEST_F(VertexLoaderTest, SpecializedMatchesInterpreted)
+{
+  constexpr int NUM_VERTICES = 64;
+  constexpr size_t ARRAY_OFFSET = 64 * 1024;
+  constexpr size_t ARRAY_SIZE = 1024 * 1024;
+  constexpr size_t OUTPUT_OFFSET = sizeof(output_memory) / 2;
+  constexpr std::array arrays = {CPArray::Position, CPArray::Normal,    CPArray::Color0,
+                                 CPArray::Color1,   CPArray::TexCoord0, CPArray::TexCoord1};
+
+  std::mt19937 rng(1234);
+  for (const auto& [vtx_desc, supported_attr] : VertexLoaderSpecialized::GetSupportedFormats())
+  {
+    VAT vtx_attr = supported_attr;
+    vtx_attr.g0.PosFrac = rng() % 32;
+    vtx_attr.SetTexFrac(0, rng() % 32);
+    vtx_attr.SetTexFrac(1, rng() % 32);
+
+    VertexLoader reference(vtx_desc, vtx_attr);
+    std::unique_ptr<VertexLoaderBase> loader = VertexLoaderSpecialized::Create(vtx_desc, vtx_attr);
+    ASSERT_NE(nullptr, loader);
+    ASSERT_EQ(reference.m_vertex_size, loader->m_vertex_size);
+    ASSERT_EQ(reference.m_native_vtx_decl.stride, loader->m_native_vtx_decl.stride);
+
+    // Bytes below 0x40 make finite floats, and indices that stay inside the arrays
+    for (size_t i = 0; i < ARRAY_OFFSET + ARRAY_SIZE; i++)
+      input_memory[i] = rng() & 0x3f;
+    for (CPArray array : arrays)
+    {
+      VertexLoaderManager::cached_arraybases[array] = input_memory + ARRAY_OFFSET;
+      g_main_cp_state.array_strides[array] = 36;
+    }
+
+    // The second vertex is skipped, which also rewinds the output
+    if (IsIndexed(vtx_desc.low.Position))
+    {
+      const size_t index_size = vtx_desc.low.Position == VertexComponentFormat::Index16 ? 2 : 1;
+      const size_t index_offset = loader->m_vertex_size + (vtx_desc.low.PosMatIdx ? 1 : 0);
+      std::memset(input_memory + index_offset, 0xFF, index_size);
+    }
+
+    VertexLoaderManager::position_cache = {};
+    VertexLoaderManager::position_matrix_index_cache = {};
+    VertexLoaderManager::normal_cache = {};
+    const int expected_count = reference.RunVertices(input_memory, output_memory, NUM_VERTICES);
+    const auto position_cache = VertexLoaderManager::position_cache;
+    const auto position_matrix_index_cache = VertexLoaderManager::position_matrix_index_cache;
+    const auto normal_cache = VertexLoaderManager::normal_cache;
+
+    VertexLoaderManager::position_cache = {};
+    VertexLoaderManager::position_matrix_index_cache = {};
+    VertexLoaderManager::normal_cache = {};
+    const int count =
+        loader->RunVertices(input_memory, output_memory + OUTPUT_OFFSET, NUM_VERTICES);
+
+    ASSERT_EQ(expected_count, count);
+    EXPECT_EQ(0, std::memcmp(output_memory, output_memory + OUTPUT_OFFSET,
+                             count * loader->m_native_vtx_decl.stride));
+    EXPECT_EQ(position_cache, VertexLoaderManager::position_cache);
+    EXPECT_EQ(position_matrix_index_cache, VertexLoaderManager::position_matrix_index_cache);
+    EXPECT_EQ(normal_cache, VertexLoaderManager::normal_cache);
+  }
+}
+
+TEST_F(VertexLoaderTest, SpecializedFallsBack)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  EXPECT_NE(nullptr, VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr));
+
+  // Texture matrix indices are never specialized
+  m_vtx_desc.low.Tex0MatIdx = true;
+  EXPECT_EQ(nullptr, VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr));
+  m_vtx_desc.low.Tex0MatIdx = false;
+
+  // Neither are colors other than RGBA8888
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGB565;
+  EXPECT_EQ(nullptr, VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr));
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  EXPECT_NE(nullptr, VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr));
+}
+
 // For gtest, which doesn't know about our fmt::formatters by default
 static void PrintTo(const VertexComponentFormat& t, std::ostream* os)
 {